@@ -0,0 +1,2 @@
+#define CPP_UTILS_CXXFLAGS "-Wall -Wextra -std=c++17 -O3 -fopenmp -pthread -march=native"
+#define CPP_UTILS_GIT_REVISION "8571cec"
@@ -0,0 +1,134 @@
+#include "allocation_tracker.hpp"
+#include "csv_reader.hpp"
+#include "dates_and_times.hpp"
+#include "doubles.hpp"
+#include "files.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace allocation_tracker_detail {
+
+thread_local ThreadAllocations thread_allocations;
+bool operators_linked = false;
+
+} // namespace allocation_tracker_detail
+
+using allocation_tracker_detail::ThreadAllocations;
+using allocation_tracker_detail::thread_allocations;
+
+AllocationCounts &AllocationCounts::operator+=(const AllocationCounts &other)
+{
+  tracked = tracked || other.tracked;
+  allocations += other.allocations;
+  deallocations += other.deallocations;
+  bytes += other.bytes;
+  peak_live_bytes = std::max(peak_live_bytes, other.peak_live_bytes);
+  return *this;
+}
+
+AllocationScope::AllocationScope(bool enabled) : enabled(enabled && allocation_tracking_available())
+{
+  if (!this->enabled) {
+    return;
+  }
+  ThreadAllocations &t = thread_allocations;
+  t.depth++;
+  start_allocations = t.allocations;
+  start_deallocations = t.deallocations;
+  start_bytes = t.bytes;
+  start_live = t.live;
+  saved_peak = t.peak;
+  t.peak = t.live;
+}
+
+AllocationScope::~AllocationScope()
+{
+  if (enabled) {
+    ThreadAllocations &t = thread_allocations;
+    t.depth--;
+    t.peak = std::max(saved_peak, t.peak);
+  }
+}
+
+// Counts since the scope started
+AllocationCounts AllocationScope::counts() const
+{
+  AllocationCounts counts;
+  if (!enabled) {
+    return counts;
+  }
+  const ThreadAllocations &t = thread_allocations;
+  counts.tracked = true;
+  counts.allocations = t.allocations - start_allocations;
+  counts.deallocations = t.deallocations - start_deallocations;
+  counts.bytes = t.bytes - start_bytes;
+  counts.peak_live_bytes = static_cast<uint64_t>(std::max<int64_t>(0, t.peak - start_live));
+  return counts;
+}
+
+// True when optional/allocation_tracking.cpp is linked in
+bool allocation_tracking_available()
+{
+  return allocation_tracker_detail::operators_linked;
+}
+
+// Prints allocations, bytes and peak live bytes per run
+void print_allocation_counts(const AllocationCounts &counts, double nb_runs, std::ostream &out)
+{
+  if (!counts.tracked) {
+    out << "  allocations not tracked" << std::endl;
+    return;
+  }
+  auto flags = out.flags();
+  auto precision = out.precision();
+  out << std::fixed << std::setprecision(1) << "  per run: " << static_cast<double>(counts.allocations) / nb_runs
+      << " allocations, " << static_cast<double>(counts.bytes) / nb_runs << " bytes, peak live "
+      << counts.peak_live_bytes << " bytes" << std::endl;
+  out.flags(flags);
+  out.precision(precision);
+}
+
+int SHOW_allocation_tracker(void)
+{
+  if (!allocation_tracking_available()) {
+    std::cout << "Allocation tracking not linked (make ALLOCATION_TRACKING=1)" << std::endl;
+    return 0;
+  }
+  const std::string filename = (std::filesystem::temp_directory_path() / "cpp_utils_allocations.csv").string();
+  {
+    std::ofstream file(filename);
+    for (int i = 0; i < 1000; i++) {
+      file << "01.02.2013 00:00:00.000;1,3611" << i << ";1,36118;1,36108;1,36115;" << 1000 + i << "\n";
+    }
+  }
+
+  double x = 0.0;
+  std::string text;
+  std::chrono::system_clock::time_point tp;
+  size_t nb_lines = 0;
+  auto show = [](const char *name, const AllocationCounts &counts) {
+    std::cout << name << ": " << counts.allocations << " allocations, " << counts.bytes << " bytes, peak live "
+              << counts.peak_live_bytes << " bytes" << std::endl;
+  };
+  // The copy of the string allocates only beyond the small string optimization (15 characters with libstdc++)
+  show("parse_double (7 characters)", count_allocations([&] { x = parse_double("1,36115", ','); }));
+  show("parse_double (20 characters)", count_allocations([&] { x = parse_double("1,361150000000000001", ','); }));
+  show("format_date_time_UTC", count_allocations([&] { text = format_date_time_UTC(tp); }));
+  show("count_lines (1000 lines)", count_allocations([&] { nb_lines = count_lines(filename, false); }));
+  show("parse_timestamp", count_allocations([&] {
+         parse_timestamp("01.02.2013 00:00:00.000", TimestampLayout::DMY, tp);
+       }));
+  std::cout << "(" << x << ", " << text << ", " << nb_lines << " lines)" << std::endl;
+
+  std::filesystem::remove(filename);
+  return 0;
+}
+
+// end
@@ -0,0 +1,85 @@
+#ifndef ALLOCATION_TRACKER_HPP
+#define ALLOCATION_TRACKER_HPP
+
+#include <cstdint>
+#include <iosfwd>
+
+// Allocation tracking, opt-in: linking optional/allocation_tracking.cpp
+// (make ALLOCATION_TRACKING=1; always in the tests) replaces the global
+// operator new and delete with ones that count the allocations of the
+// calling thread while an AllocationScope is alive on it (one thread-local
+// test otherwise). Without it, the standard operators are kept and
+// nothing is tracked. Memory obtained with malloc directly is not seen.
+
+struct AllocationCounts {
+  bool tracked = false;        // false when tracking is not linked
+  uint64_t allocations = 0;    // operator new calls
+  uint64_t deallocations = 0;  // operator delete calls
+  uint64_t bytes = 0;          // requested from operator new
+  uint64_t peak_live_bytes = 0; // highest memory in use above the start of the scope (allocator block sizes)
+
+  AllocationCounts &operator+=(const AllocationCounts &other); // sums, except the peak (max)
+};
+
+/**
+ * Counts the allocations of the calling thread from construction to
+ * counts() (scopes may nest). Allocations made by other threads, e.g. by
+ * a pool the code hands work to, are not counted.
+ *
+ * Example:
+ *   AllocationScope scope;
+ *   std::string text = format_date_time_UTC(tp);
+ *   scope.counts().allocations // the ostringstream's buffers and the string
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+class AllocationScope {
+public:
+  explicit AllocationScope(bool enabled = true);
+  ~AllocationScope();
+  AllocationScope(const AllocationScope &) = delete;
+  AllocationScope &operator=(const AllocationScope &) = delete;
+
+  AllocationCounts counts() const;
+
+private:
+  bool enabled;
+  uint64_t start_allocations = 0;
+  uint64_t start_deallocations = 0;
+  uint64_t start_bytes = 0;
+  int64_t start_live = 0;
+  int64_t saved_peak = 0;
+};
+
+// Allocations made by a call of fn on the calling thread
+template <typename Fn>
+AllocationCounts count_allocations(Fn &&fn)
+{
+  AllocationScope scope;
+  fn();
+  return scope.counts();
+}
+
+namespace allocation_tracker_detail {
+
+// Counters of the calling thread; trivial, hence usable in operator new
+// at any time (no dynamic initialization, no destruction)
+struct ThreadAllocations {
+  int depth;            // number of live AllocationScope
+  uint64_t allocations;
+  uint64_t deallocations;
+  uint64_t bytes;
+  int64_t live;         // allocator block sizes allocated minus freed while depth > 0
+  int64_t peak;         // highest live since the innermost scope started
+};
+
+extern thread_local ThreadAllocations thread_allocations;
+extern bool operators_linked; // set by optional/allocation_tracking.cpp
+
+} // namespace allocation_tracker_detail
+
+bool allocation_tracking_available();
+void print_allocation_counts(const AllocationCounts &counts, double nb_runs, std::ostream &out);
+int SHOW_allocation_tracker(void);
+
+#endif // ALLOCATION_TRACKER_HPP
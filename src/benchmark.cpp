@@ -0,0 +1,518 @@
+#include "benchmark.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace {
+
+// 97.5% quantile of Student's t distribution with df >= 1 degrees of freedom
+double student_t_975(size_t df)
+{
+  static const double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                 2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                 2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+  if (df <= 30) {
+    return table[df - 1];
+  }
+  return 1.960 + 2.4 / static_cast<double>(df); // within 0.005 beyond 30
+}
+
+// Mean and sample standard deviation of values (not empty)
+void mean_and_stddev(const std::vector<double> &values, double &mean, double &stddev)
+{
+  const size_t n = values.size();
+  mean = std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(n);
+  double sum_squares = 0.0;
+  for (double v : values) {
+    sum_squares += (v - mean) * (v - mean);
+  }
+  stddev = (n > 1) ? std::sqrt(sum_squares / static_cast<double>(n - 1)) : 0.0;
+}
+
+// Half-width of the 95% confidence interval of the mean of n values
+double confidence_half_width(double stddev, size_t n)
+{
+  return (n > 1) ? student_t_975(n - 1) * stddev / std::sqrt(static_cast<double>(n)) : 0.0;
+}
+
+// First line of a (sysfs) file, empty if unreadable
+std::string read_first_line(const std::string &filename)
+{
+  std::ifstream file(filename);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+// CPUs of a sysfs CPU list such as "0-3,8"
+std::vector<int> parse_cpu_list(const std::string &list)
+{
+  std::vector<int> cpus;
+  std::stringstream ss(list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    size_t dash = range.find('-');
+    try {
+      int first = std::stoi(range.substr(0, dash));
+      int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+      for (int cpu = first; cpu <= last; cpu++) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::exception &) {
+    }
+  }
+  return cpus;
+}
+
+// Busy and total jiffies of each CPU, from /proc/stat
+std::vector<std::pair<unsigned long long, unsigned long long>> cpu_times()
+{
+  std::vector<std::pair<unsigned long long, unsigned long long>> times;
+  std::ifstream stat("/proc/stat");
+  std::string line;
+  while (std::getline(stat, line)) {
+    if (line.compare(0, 3, "cpu") != 0 || line.size() < 4 || !std::isdigit(static_cast<unsigned char>(line[3]))) {
+      continue;
+    }
+    std::istringstream fields(line.substr(3));
+    size_t cpu = 0;
+    unsigned long long value = 0, total = 0, idle = 0;
+    fields >> cpu;
+    for (int i = 0; fields >> value; i++) {
+      total += value;
+      if (i == 3 || i == 4) { // idle, iowait
+        idle += value;
+      }
+    }
+    if (times.size() <= cpu) {
+      times.resize(cpu + 1);
+    }
+    times[cpu] = {total - idle, total};
+  }
+  return times;
+}
+
+} // namespace
+
+namespace benchmark_detail {
+
+bool enough_runs(const std::vector<double> &durations, const BenchmarkOptions &options, double total_seconds)
+{
+  const int n = static_cast<int>(durations.size());
+  if (n < std::max(options.min_runs, 1)) {
+    return false;
+  }
+  if (n >= options.max_runs || total_seconds >= options.max_seconds) {
+    return true;
+  }
+  if (n < 2) {
+    return false;
+  }
+  double mean = 0.0;
+  double stddev = 0.0;
+  mean_and_stddev(durations, mean, stddev);
+  // Strict, so that a target of 0 runs max_runs even when all durations are equal (coarse clock)
+  return confidence_half_width(stddev, durations.size()) < options.target_relative_ci * mean;
+}
+
+void print_run(size_t run, double seconds)
+{
+  std::cout << "Run " << run << ": " << std::fixed << std::setprecision(6) << seconds << " seconds" << std::endl;
+}
+
+} // namespace benchmark_detail
+
+/**
+ * Returns the p-th percentile (p in [0, 100]) of values, by linear
+ * interpolation between closest ranks.
+ *
+ * @throws std::invalid_argument if values is empty
+ *
+ * Example:
+ *   percentile({1.0, 2.0, 3.0, 4.0}, 50.0) // 2.5
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+double percentile(std::vector<double> values, double p)
+{
+  if (values.empty()) {
+    throw std::invalid_argument("Percentile of no values");
+  }
+  std::sort(values.begin(), values.end());
+  double rank = std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(values.size() - 1);
+  size_t lower = static_cast<size_t>(rank);
+  if (lower + 1 >= values.size()) {
+    return values.back();
+  }
+  double fraction = rank - static_cast<double>(lower);
+  return values[lower] + fraction * (values[lower + 1] - values[lower]);
+}
+
+/**
+ * Two-sided p-value of the Mann-Whitney U test: the probability, if a and
+ * b come from the same distribution, of a rank difference at least as
+ * large as observed. Unlike a t-test, it assumes no normality, which suits
+ * skewed timing distributions.
+ *
+ * Normal approximation with tie and continuity corrections (good from
+ * about 5 values per sample). Returns 1 if a sample is empty or all values
+ * are equal.
+ *
+ * Example:
+ *   mann_whitney_p_value(old_run.durations, new_run.durations) < 0.01 // significant difference
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+double mann_whitney_p_value(const std::vector<double> &a, const std::vector<double> &b)
+{
+  const double n1 = static_cast<double>(a.size());
+  const double n2 = static_cast<double>(b.size());
+  if (a.empty() || b.empty()) {
+    return 1.0;
+  }
+  std::vector<std::pair<double, bool>> values; // value, from a
+  for (double v : a) {
+    values.emplace_back(v, true);
+  }
+  for (double v : b) {
+    values.emplace_back(v, false);
+  }
+  std::sort(values.begin(), values.end(), [](const auto &x, const auto &y) { return x.first < y.first; });
+
+  // Sum of the ranks of a (ties get their average rank), and tie correction
+  double rank_sum = 0.0;
+  double ties = 0.0;
+  for (size_t i = 0; i < values.size();) {
+    size_t j = i;
+    while (j < values.size() && values[j].first == values[i].first) {
+      j++;
+    }
+    double average_rank = static_cast<double>(i + j + 1) / 2.0;
+    double t = static_cast<double>(j - i);
+    ties += t * t * t - t;
+    for (size_t k = i; k < j; k++) {
+      if (values[k].second) {
+        rank_sum += average_rank;
+      }
+    }
+    i = j;
+  }
+
+  const double n = n1 + n2;
+  const double u = rank_sum - n1 * (n1 + 1.0) / 2.0;
+  const double mean = n1 * n2 / 2.0;
+  const double variance = n1 * n2 / 12.0 * ((n + 1.0) - ties / (n * (n - 1.0)));
+  if (variance <= 0.0) {
+    return 1.0;
+  }
+  double z = std::max(0.0, std::abs(u - mean) - 0.5) / std::sqrt(variance);
+  return std::erfc(z / std::sqrt(2.0));
+}
+
+/**
+ * Computes the statistics of benchmark durations: min, max, mean, median,
+ * standard deviation, MAD, p90, p99 and the 95% confidence interval of the
+ * mean (Student's t).
+ *
+ * The median and MAD are robust to the outliers (preemption, interrupts)
+ * that inflate mean and standard deviation; outliers (see find_outliers)
+ * are also listed, and left out of the adjusted mean.
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+BenchmarkResult summarize_durations(std::vector<double> durations, double outlier_threshold)
+{
+  BenchmarkResult result;
+  result.durations = std::move(durations);
+  const std::vector<double> &d = result.durations;
+  if (d.empty()) {
+    return result;
+  }
+  result.min = *std::min_element(d.begin(), d.end());
+  result.max = *std::max_element(d.begin(), d.end());
+  mean_and_stddev(d, result.mean, result.stddev);
+  result.ci95 = confidence_half_width(result.stddev, d.size());
+  result.median = percentile(d, 50.0);
+  result.p90 = percentile(d, 90.0);
+  result.p99 = percentile(d, 99.0);
+  std::vector<double> deviations(d.size());
+  std::transform(d.begin(), d.end(), deviations.begin(), [&](double v) { return std::abs(v - result.median); });
+  result.mad = percentile(deviations, 50.0);
+
+  result.outliers = find_outliers(d, outlier_threshold);
+  std::vector<double> kept;
+  for (size_t i = 0, o = 0; i < d.size(); i++) {
+    if (o < result.outliers.size() && result.outliers[o] == i) {
+      o++;
+    } else {
+      kept.push_back(d[i]);
+    }
+  }
+  double kept_stddev = 0.0;
+  mean_and_stddev(kept, result.adjusted_mean, kept_stddev);
+  result.adjusted_ci95 = confidence_half_width(kept_stddev, kept.size());
+  return result;
+}
+
+/**
+ * Returns the indices of the outliers of values: those whose modified
+ * z-score 0.6745 * |x - median| / MAD exceeds threshold (Iglewicz and
+ * Hoaglin; 3.5 is customary). Based on the median and the MAD, the
+ * criterion is not skewed by the outliers themselves, unlike mean +/- k
+ * standard deviations.
+ *
+ * Example:
+ *   find_outliers({1.0, 1.1, 0.9, 1.0, 5.0}) // {4}
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+std::vector<size_t> find_outliers(const std::vector<double> &values, double threshold)
+{
+  std::vector<size_t> outliers;
+  if (values.size() < 3) {
+    return outliers;
+  }
+  const double median = percentile(values, 50.0);
+  std::vector<double> deviations(values.size());
+  std::transform(values.begin(), values.end(), deviations.begin(), [&](double v) { return std::abs(v - median); });
+  double scale = percentile(deviations, 50.0) / 0.6745;
+  if (scale == 0.0) { // more than half of the values are equal: use the mean absolute deviation
+    scale = std::accumulate(deviations.begin(), deviations.end(), 0.0) / static_cast<double>(values.size()) / 0.7979;
+  }
+  if (scale == 0.0) {
+    return outliers;
+  }
+  for (size_t i = 0; i < values.size(); i++) {
+    if (deviations[i] / scale > threshold) {
+      outliers.push_back(i);
+    }
+  }
+  return outliers;
+}
+
+// 1-minute load average (-1 if unknown)
+double load_average()
+{
+  std::ifstream file("/proc/loadavg");
+  double load = -1.0;
+  if (!(file >> load)) {
+    return -1.0;
+  }
+  return load;
+}
+
+// CPU the calling thread runs on (-1 if unknown)
+int current_cpu()
+{
+#if defined(__linux__)
+  return ::sched_getcpu();
+#else
+  return -1;
+#endif
+}
+
+// Last CPU the calling thread may run on (its affinity mask, e.g. a
+// cpuset), the farthest from CPU 0 and its interrupts (-1 if unknown)
+int last_allowed_cpu()
+{
+#if defined(__linux__)
+  cpu_set_t mask;
+  if (::sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+    for (int cpu = CPU_SETSIZE - 1; cpu >= 0; cpu--) {
+      if (CPU_ISSET(cpu, &mask)) {
+        return cpu;
+      }
+    }
+  }
+#endif
+  return -1;
+}
+
+CpuPinning::CpuPinning(int cpu)
+{
+#if defined(__linux__)
+  cpu_set_t previous;
+  if (cpu < 0 || cpu >= CPU_SETSIZE || ::sched_getaffinity(0, sizeof(previous), &previous) != 0) {
+    return;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  if (::sched_setaffinity(0, sizeof(set), &set) == 0) {
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&previous);
+    saved_mask.assign(bytes, bytes + sizeof(previous));
+    ok = true;
+  }
+#else
+  (void)cpu;
+#endif
+}
+
+CpuPinning::~CpuPinning()
+{
+#if defined(__linux__)
+  if (ok) {
+    cpu_set_t previous;
+    std::copy(saved_mask.begin(), saved_mask.end(), reinterpret_cast<unsigned char *>(&previous));
+    ::sched_setaffinity(0, sizeof(previous), &previous);
+  }
+#endif
+}
+
+/**
+ * Checks conditions that make benchmark runs vary, for a benchmark on
+ * `cpu` (Linux): a CPU frequency governor other than "performance", turbo
+ * boost, a busy SMT sibling of `cpu` (sampled over 50 ms), and a load
+ * average above 1.5 (other processes compete for the CPUs).
+ *
+ * @param cpu CPU the benchmark runs on (-1: CPU 0)
+ * @return std::vector<std::string> Warnings, empty if none
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+std::vector<std::string> check_benchmark_environment(int cpu)
+{
+  std::vector<std::string> warnings;
+#if defined(__linux__)
+  cpu = std::max(cpu, 0);
+  const std::string cpu_dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+
+  std::string governor = read_first_line(cpu_dir + "/cpufreq/scaling_governor");
+  if (!governor.empty() && governor != "performance") {
+    warnings.push_back("CPU " + std::to_string(cpu) + " governor is '" + governor + "', not 'performance'");
+  }
+  if (read_first_line("/sys/devices/system/cpu/intel_pstate/no_turbo") == "0" ||
+      read_first_line("/sys/devices/system/cpu/cpufreq/boost") == "1") {
+    warnings.push_back("Turbo boost is enabled: frequency depends on load and temperature");
+  }
+
+  std::vector<int> siblings = parse_cpu_list(read_first_line(cpu_dir + "/topology/thread_siblings_list"));
+  siblings.erase(std::remove(siblings.begin(), siblings.end(), cpu), siblings.end());
+  if (!siblings.empty()) {
+    auto before = cpu_times();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto after = cpu_times();
+    for (int sibling : siblings) {
+      size_t s = static_cast<size_t>(sibling);
+      if (s >= before.size() || s >= after.size() || after[s].second <= before[s].second) {
+        continue;
+      }
+      double busy = static_cast<double>(after[s].first - before[s].first) /
+                    static_cast<double>(after[s].second - before[s].second);
+      if (busy > 0.1) {
+        warnings.push_back("SMT sibling CPU " + std::to_string(sibling) + " is busy (" +
+                           std::to_string(static_cast<int>(100.0 * busy)) + " %)");
+      }
+    }
+  }
+
+  double load = load_average();
+  if (load > 1.5) {
+    std::ostringstream message;
+    message << "Load average is " << load << ": other processes compete for the CPUs";
+    warnings.push_back(message.str());
+  }
+#else
+  (void)cpu;
+  warnings.push_back("Environment checks are only supported on Linux");
+#endif
+  return warnings;
+}
+
+void print_benchmark_result(const std::string &name, const BenchmarkResult &result, std::ostream &out)
+{
+  auto flags = out.flags();
+  auto precision = out.precision();
+  out << std::fixed << std::setprecision(6);
+  out << name << ": " << result.durations.size() << " runs, median " << result.median << " s (MAD " << result.mad
+      << "), mean " << result.mean << " s +/- " << result.ci95 << " (95% CI), stddev " << result.stddev << std::endl;
+  out << "  min " << result.min << " s, p90 " << result.p90 << " s, p99 " << result.p99 << " s, max " << result.max
+      << " s = min + " << static_cast<long>(result.min > 0.0 ? 100.0 * (result.max - result.min) / result.min : 0.0)
+      << " %" << std::endl;
+  if (result.items_per_run != 1.0) {
+    out << "  median per item: " << std::setprecision(3) << 1e9 * result.median / result.items_per_run << " ns"
+        << std::endl;
+  }
+  if (result.counters.available != 0) {
+    print_perf_counts(result.counters, result.items_per_run * static_cast<double>(result.durations.size()), out);
+  }
+  if (result.allocations.tracked) {
+    print_allocation_counts(result.allocations, static_cast<double>(result.durations.size()), out);
+  }
+  if (!result.outliers.empty()) {
+    out << std::setprecision(6) << "  without " << result.outliers.size() << " outlier run(s): mean "
+        << result.adjusted_mean << " s +/- " << result.adjusted_ci95 << " (95% CI)" << std::endl;
+  }
+  if (result.pinned_cpu >= 0) {
+    out << "  pinned to CPU " << result.pinned_cpu;
+  } else {
+    out << "  not pinned, " << result.nb_migrations << " run(s) migrated";
+  }
+  if (result.load_average >= 0.0) {
+    out << ", load average " << std::setprecision(2) << result.load_average;
+  }
+  out << std::endl;
+  for (const std::string &warning : result.warnings) {
+    out << "  warning: " << warning << std::endl;
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
+
+void print_benchmark_result(const std::string &name, const BenchmarkResult &result)
+{
+  print_benchmark_result(name, result, std::cout);
+}
+
+int SHOW_benchmark(void)
+{
+  std::vector<double> values(1 << 20);
+  std::iota(values.begin(), values.end(), 0.0);
+
+  BenchmarkOptions options;
+  options.max_seconds = 1.0;
+
+  // Without a barrier, the unused sum may be deleted by the optimizer
+  BenchmarkResult unused = benchmark(
+      [&values] {
+        double sum = 0.0;
+        for (double v : values) {
+          sum += v;
+        }
+        (void)sum;
+      },
+      options);
+  BenchmarkResult used = benchmark(
+      [&values] {
+        double sum = 0.0;
+        for (double v : values) {
+          sum += v;
+        }
+        do_not_optimize(sum);
+      },
+      options);
+  print_benchmark_result("Sum, result unused", unused);
+  print_benchmark_result("Sum, result passed to do_not_optimize", used);
+
+  // Returning the result has the same effect
+  BenchmarkResult returned = benchmark([&values] { return std::accumulate(values.begin(), values.end(), 0.0); }, options);
+  print_benchmark_result("Sum, result returned", returned);
+  return 0;
+}
+
+// end
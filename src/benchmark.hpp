@@ -0,0 +1,249 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include "allocation_tracker.hpp"
+#include "perf_counters.hpp"
+#include "stopwatch.hpp"
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+struct BenchmarkOptions {
+  int warmup_runs = 1;              // unmeasured runs first (caches, page faults, frequency ramp-up)
+  int min_runs = 5;                 // measured runs, at least
+  int max_runs = 100;               // measured runs, at most
+  double max_seconds = 10.0;        // no new run once the measured runs total this
+  double target_relative_ci = 0.01; // stop when the 95% confidence interval of the mean is within +/- 1%
+  bool verbose = false;             // print each run
+  unsigned perf_counters = 0;       // PerfCounter bits to collect on each measured run (0 = none)
+  double items_per_run = 1.0;       // items processed by a run (rows, numbers, ...), for per-item metrics
+  int pin_cpu = -1;                 // run on this CPU only (sched_setaffinity), -1 = no pinning
+  bool check_environment = false;   // warn about CPU governor, turbo, busy SMT siblings and load
+  double outlier_threshold = 3.5;   // modified z-score beyond which a run is an outlier
+  bool track_allocations = false;   // count the allocations of each measured run (see allocation_tracker.hpp)
+};
+
+struct BenchmarkResult {
+  std::vector<double> durations; // seconds, one per measured run, in order
+  double min = 0.0;
+  double max = 0.0;
+  double mean = 0.0;
+  double median = 0.0;
+  double stddev = 0.0; // sample standard deviation
+  double mad = 0.0;    // median absolute deviation from the median (unscaled)
+  double p90 = 0.0;
+  double p99 = 0.0;
+  double ci95 = 0.0; // half-width of the 95% confidence interval of the mean
+  PerfCounts counters; // summed over the measured runs
+  AllocationCounts allocations; // summed over the measured runs (peak: of the worst run)
+  double items_per_run = 1.0;
+
+  // Noise
+  std::vector<size_t> outliers; // indices of outlier runs (interrupted, preempted, ...)
+  double adjusted_mean = 0.0;   // mean of the other runs
+  double adjusted_ci95 = 0.0;   // half-width of the 95% confidence interval of adjusted_mean
+  int pinned_cpu = -1;
+  int nb_migrations = 0;        // runs that ended on another CPU than they started on
+  double load_average = -1.0;   // 1-minute load average before the runs (-1 if unknown)
+  std::vector<std::string> warnings;
+};
+
+// Pins the calling thread to one CPU, until destruction (the previous
+// affinity is then restored); does nothing if the CPU cannot be used
+class CpuPinning {
+public:
+  explicit CpuPinning(int cpu);
+  ~CpuPinning();
+  CpuPinning(const CpuPinning &) = delete;
+  CpuPinning &operator=(const CpuPinning &) = delete;
+
+  bool pinned() const { return ok; }
+
+private:
+  std::vector<unsigned char> saved_mask;
+  bool ok = false;
+};
+
+/**
+ * Prevents the compiler from optimizing away the computation of value, or
+ * from assuming anything about it (the value is "used" by an empty asm
+ * statement that may read memory).
+ */
+template <typename T>
+inline void do_not_optimize(const T &value)
+{
+#if defined(_MSC_VER)
+  static const void *volatile sink;
+  sink = &value;
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/**
+ * Forces pending writes to memory to be considered visible: stores before
+ * the barrier cannot be removed as dead, nor moved after it.
+ */
+inline void clobber_memory()
+{
+#if defined(_MSC_VER)
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : : "memory");
+#endif
+}
+
+BenchmarkResult summarize_durations(std::vector<double> durations, double outlier_threshold = 3.5);
+double percentile(std::vector<double> values, double p);
+std::vector<size_t> find_outliers(const std::vector<double> &values, double threshold = 3.5);
+std::vector<std::string> check_benchmark_environment(int cpu);
+double load_average();
+int current_cpu();
+int last_allowed_cpu();
+double mann_whitney_p_value(const std::vector<double> &a, const std::vector<double> &b);
+void print_benchmark_result(const std::string &name, const BenchmarkResult &result, std::ostream &out);
+void print_benchmark_result(const std::string &name, const BenchmarkResult &result);
+int SHOW_benchmark(void);
+
+namespace benchmark_detail {
+
+template <typename T>
+struct is_duration : std::false_type {};
+
+template <typename Rep, typename Period>
+struct is_duration<std::chrono::duration<Rep, Period>> : std::true_type {};
+
+bool enough_runs(const std::vector<double> &durations, const BenchmarkOptions &options, double total_seconds);
+void print_run(size_t run, double seconds);
+
+// Duration of one call of fn, in seconds: the returned duration for a
+// self-timing callable, else timed with a Stopwatch
+template <typename Fn>
+double time_call(Fn &fn)
+{
+  using Result = std::invoke_result_t<Fn &>;
+  if constexpr (is_duration<Result>::value) {
+    return std::chrono::duration<double>(fn()).count();
+  } else {
+    Stopwatch sw;
+    if constexpr (std::is_void_v<Result>) {
+      fn();
+      clobber_memory();
+    } else {
+      do_not_optimize(fn());
+    }
+    return sw.elapsed_seconds();
+  }
+}
+
+} // namespace benchmark_detail
+
+/**
+ * Benchmarks a callable: warm-up runs, then measured runs until the 95%
+ * confidence interval of the mean is tight enough (or the run or time
+ * limits are reached), and statistics of the measured durations.
+ *
+ * The callable takes no argument. If it returns a std::chrono::duration,
+ * this is taken as the duration of the run (the callable measures itself,
+ * and may do other things outside of the measured section, e.g. printing
+ * a result); otherwise the whole call is timed with a Stopwatch (TSC), and the
+ * returned value, if any, is passed to do_not_optimize.
+ *
+ * With options.perf_counters, hardware counters are collected on each
+ * measured run (the whole call, for a self-timing callable) and summed;
+ * if they are not permitted, the result simply has none. Likewise with
+ * options.track_allocations, for the allocations made by the calling
+ * thread (a hot path can then be required to make none).
+ *
+ * To reduce noise, the thread can be pinned to options.pin_cpu (no
+ * migration, warm private caches), and options.check_environment reports
+ * conditions that make runs vary (see check_benchmark_environment). Runs
+ * whose modified z-score exceeds options.outlier_threshold are reported
+ * as outliers and left out of the adjusted mean.
+ *
+ * @param fn Callable to benchmark
+ * @param options Warm-up, run count, time and precision limits
+ * @return BenchmarkResult Durations, in seconds, and their statistics
+ *
+ * Example:
+ *   BenchmarkResult r = benchmark([] { return calculate_pi_leibniz(100'000'000); });
+ *   print_benchmark_result("Leibniz", r);
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+template <typename Fn>
+BenchmarkResult benchmark(Fn &&fn, const BenchmarkOptions &options = BenchmarkOptions())
+{
+  std::unique_ptr<CpuPinning> pinning;
+  if (options.pin_cpu >= 0) {
+    pinning = std::make_unique<CpuPinning>(options.pin_cpu);
+  }
+  std::vector<std::string> warnings;
+  if (options.pin_cpu >= 0 && !pinning->pinned()) {
+    warnings.push_back("Cannot pin to CPU " + std::to_string(options.pin_cpu));
+  }
+  if (options.check_environment) {
+    for (const std::string &warning : check_benchmark_environment(current_cpu())) {
+      warnings.push_back(warning);
+    }
+  }
+  const double load = load_average();
+
+  PerfCounts counters;
+  AllocationCounts allocations;
+  std::unique_ptr<PerfCounterGroup> group;
+  if (options.perf_counters != 0) {
+    group = std::make_unique<PerfCounterGroup>(options.perf_counters);
+  }
+
+  auto run_once = [&fn]() { return benchmark_detail::time_call(fn); };
+
+  for (int i = 0; i < options.warmup_runs; i++) {
+    run_once();
+  }
+
+  std::vector<double> durations;
+  double total_seconds = 0.0;
+  int nb_migrations = 0;
+  while (!benchmark_detail::enough_runs(durations, options, total_seconds)) {
+    const int cpu = current_cpu();
+    double seconds = 0.0;
+    AllocationScope allocation_scope(options.track_allocations);
+    if (group) {
+      PerfScope scope(*group, counters);
+      seconds = run_once();
+    } else {
+      seconds = run_once();
+    }
+    if (options.track_allocations) {
+      allocations += allocation_scope.counts();
+    }
+    nb_migrations += (current_cpu() != cpu);
+    durations.push_back(seconds);
+    total_seconds += seconds;
+    if (options.verbose) {
+      benchmark_detail::print_run(durations.size(), seconds);
+    }
+  }
+  BenchmarkResult result = summarize_durations(std::move(durations), options.outlier_threshold);
+  result.counters = counters;
+  result.allocations = allocations;
+  result.items_per_run = options.items_per_run;
+  result.pinned_cpu = (pinning && pinning->pinned()) ? options.pin_cpu : -1;
+  result.nb_migrations = nb_migrations;
+  result.load_average = load;
+  result.warnings = std::move(warnings);
+  return result;
+}
+
+#endif // BENCHMARK_HPP
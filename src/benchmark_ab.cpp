@@ -0,0 +1,192 @@
+#include "benchmark_ab.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Median of values (not empty), reordered
+double median_of(std::vector<double> &values)
+{
+  const size_t middle = values.size() / 2;
+  std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(middle), values.end());
+  double upper = values[middle];
+  if (values.size() % 2 == 1) {
+    return upper;
+  }
+  double lower = *std::max_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(middle));
+  return (lower + upper) / 2.0;
+}
+
+} // namespace
+
+namespace benchmark_detail {
+
+bool enough_pairs(const ABResult &result, const ABOptions &options, double total_seconds)
+{
+  const int n = static_cast<int>(result.a.durations.size());
+  if (n < std::max(options.min_pairs, 2)) {
+    return false;
+  }
+  if (n >= options.max_pairs || total_seconds >= options.max_seconds) {
+    return true;
+  }
+  if (n % 5 != 0) { // the bootstrap is not free: check every 5 pairs
+    return false;
+  }
+  auto [low, high] = bootstrap_ratio_interval(result.a.durations, result.b.durations, options.confidence,
+                                              options.nb_resamples, options.seed);
+  return high - low <= options.target_ci_width;
+}
+
+void print_pair(size_t pair, double seconds_a, double seconds_b)
+{
+  std::cout << "Pair " << pair << ": A " << std::fixed << std::setprecision(6) << seconds_a << " s, B " << seconds_b
+            << " s" << std::endl;
+}
+
+} // namespace benchmark_detail
+
+/**
+ * Bootstrap confidence interval (percentile method) of the ratio
+ * median(b) / median(a). When a and b have the same size, they are taken
+ * as pairs of interleaved runs and resampled together, which keeps what
+ * the runs of a pair have in common (drift) out of the interval;
+ * otherwise they are resampled independently.
+ *
+ * @param a Durations of variant A (not empty)
+ * @param b Durations of variant B (not empty)
+ * @param confidence Confidence level, e.g. 0.95
+ * @param nb_resamples Number of bootstrap resamples
+ * @param seed Seed of the resampling
+ * @return std::pair<double, double> Lower and upper bounds of the ratio
+ *
+ * Example:
+ *   bootstrap_ratio_interval({1.0, 1.1, 0.9}, {0.5, 0.55, 0.45}) // around 0.5
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+std::pair<double, double> bootstrap_ratio_interval(const std::vector<double> &a, const std::vector<double> &b,
+                                                   double confidence, int nb_resamples, uint64_t seed)
+{
+  if (a.empty() || b.empty()) {
+    return {1.0, 1.0};
+  }
+  const bool paired = a.size() == b.size();
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<size_t> pick_a(0, a.size() - 1);
+  std::uniform_int_distribution<size_t> pick_b(0, b.size() - 1);
+  std::vector<double> sample_a(a.size());
+  std::vector<double> sample_b(b.size());
+  std::vector<double> ratios;
+  ratios.reserve(static_cast<size_t>(std::max(nb_resamples, 1)));
+  for (int r = 0; r < std::max(nb_resamples, 1); r++) {
+    for (size_t i = 0; i < a.size(); i++) {
+      size_t j = pick_a(rng);
+      sample_a[i] = a[j];
+      if (paired) {
+        sample_b[i] = b[j];
+      }
+    }
+    if (!paired) {
+      for (size_t i = 0; i < b.size(); i++) {
+        sample_b[i] = b[pick_b(rng)];
+      }
+    }
+    double median_a = median_of(sample_a);
+    if (median_a > 0.0) {
+      ratios.push_back(median_of(sample_b) / median_a);
+    }
+  }
+  if (ratios.empty()) {
+    return {1.0, 1.0};
+  }
+  const double tail = 100.0 * (1.0 - confidence) / 2.0;
+  return {percentile(ratios, tail), percentile(ratios, 100.0 - tail)};
+}
+
+/**
+ * Verdict of an A/B comparison. No practical difference when the whole
+ * interval of the ratio is within 1 +/- options.equivalence (even if
+ * significant); otherwise B is faster or slower when the Mann-Whitney
+ * test is significant at 1 - options.confidence and the whole interval
+ * is on one side of 1; otherwise inconclusive.
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+ABVerdict ab_verdict(double ratio_low, double ratio_high, double p_value, const ABOptions &options)
+{
+  if (ratio_low >= 1.0 - options.equivalence && ratio_high <= 1.0 + options.equivalence) {
+    return ABVerdict::EQUIVALENT;
+  }
+  const bool significant = p_value < 1.0 - options.confidence;
+  if (significant && ratio_high < 1.0) {
+    return ABVerdict::B_FASTER;
+  }
+  if (significant && ratio_low > 1.0) {
+    return ABVerdict::B_SLOWER;
+  }
+  return ABVerdict::INCONCLUSIVE;
+}
+
+// Statistics, ratio, interval, p-value and verdict, from the durations of result.a and result.b
+void summarize_ab(ABResult &result, const ABOptions &options)
+{
+  result.a = summarize_durations(std::move(result.a.durations));
+  result.b = summarize_durations(std::move(result.b.durations));
+  result.ratio = result.a.median > 0.0 ? result.b.median / result.a.median : 1.0;
+  std::tie(result.ratio_low, result.ratio_high) = bootstrap_ratio_interval(
+      result.a.durations, result.b.durations, options.confidence, options.nb_resamples, options.seed);
+  result.p_value = mann_whitney_p_value(result.a.durations, result.b.durations);
+  result.verdict = ab_verdict(result.ratio_low, result.ratio_high, result.p_value, options);
+}
+
+const char *ab_verdict_name(ABVerdict verdict)
+{
+  switch (verdict) {
+  case ABVerdict::B_FASTER:
+    return "B is faster";
+  case ABVerdict::B_SLOWER:
+    return "B is slower";
+  case ABVerdict::EQUIVALENT:
+    return "no practical difference";
+  case ABVerdict::INCONCLUSIVE:
+    break;
+  }
+  return "inconclusive";
+}
+
+// Prints both variants, the ratio with its interval, the p-value and the verdict
+void print_ab_result(const std::string &name_a, const std::string &name_b, const ABResult &result, std::ostream &out)
+{
+  auto flags = out.flags();
+  auto precision = out.precision();
+  out << std::fixed << std::setprecision(6);
+  out << "A = " << name_a << ": median " << result.a.median << " s, mean " << result.a.mean << " s +/- "
+      << result.a.ci95 << std::endl;
+  out << "B = " << name_b << ": median " << result.b.median << " s, mean " << result.b.mean << " s +/- "
+      << result.b.ci95 << std::endl;
+  out << std::setprecision(4) << "B / A = " << result.ratio << " [" << result.ratio_low << ", " << result.ratio_high
+      << "] (bootstrap interval), Mann-Whitney p = " << std::scientific << std::setprecision(2) << result.p_value
+      << ", " << result.a.durations.size() << " pairs" << std::endl;
+  out << "Verdict: " << ab_verdict_name(result.verdict);
+  if (result.verdict == ABVerdict::B_FASTER || result.verdict == ABVerdict::B_SLOWER) {
+    out << std::fixed << std::setprecision(1) << " (" << std::abs(100.0 * (result.ratio - 1.0)) << " %)";
+  }
+  out << std::endl;
+  out.flags(flags);
+  out.precision(precision);
+}
+
+void print_ab_result(const std::string &name_a, const std::string &name_b, const ABResult &result)
+{
+  print_ab_result(name_a, name_b, result, std::cout);
+}
+
+// end
@@ -0,0 +1,119 @@
+#ifndef BENCHMARK_AB_HPP
+#define BENCHMARK_AB_HPP
+
+#include "benchmark.hpp"
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct ABOptions {
+  int warmup_runs = 1;           // unmeasured runs of each variant first
+  int min_pairs = 10;            // measured (A, B) pairs, at least
+  int max_pairs = 200;           // measured pairs, at most
+  double max_seconds = 30.0;     // no new pair once the measured runs total this
+  double target_ci_width = 0.02; // stop when the confidence interval of the ratio is narrower than this
+  double confidence = 0.95;      // of the bootstrap interval; the test uses alpha = 1 - confidence
+  double equivalence = 0.01;     // ratios within 1 +/- this are no practical difference
+  int nb_resamples = 2000;       // bootstrap resamples
+  uint64_t seed = 42;            // of the bootstrap (reproducible verdicts)
+  int pin_cpu = -1;              // run on this CPU only, -1 = no pinning
+  bool verbose = false;          // print each pair
+};
+
+enum class ABVerdict {
+  B_FASTER,     // significant, and the whole interval is below 1
+  B_SLOWER,     // significant, and the whole interval is above 1
+  EQUIVALENT,   // the whole interval is within 1 +/- equivalence
+  INCONCLUSIVE, // more runs (or less noise) needed
+};
+
+struct ABResult {
+  BenchmarkResult a;
+  BenchmarkResult b;
+  double ratio = 1.0;      // median of B / median of A (< 1: B is faster)
+  double ratio_low = 1.0;  // bootstrap confidence interval of the ratio
+  double ratio_high = 1.0;
+  double p_value = 1.0;    // Mann-Whitney U test on the durations
+  ABVerdict verdict = ABVerdict::INCONCLUSIVE;
+};
+
+std::pair<double, double> bootstrap_ratio_interval(const std::vector<double> &a, const std::vector<double> &b,
+                                                   double confidence = 0.95, int nb_resamples = 2000,
+                                                   uint64_t seed = 42);
+ABVerdict ab_verdict(double ratio_low, double ratio_high, double p_value, const ABOptions &options);
+void summarize_ab(ABResult &result, const ABOptions &options);
+void print_ab_result(const std::string &name_a, const std::string &name_b, const ABResult &result, std::ostream &out);
+void print_ab_result(const std::string &name_a, const std::string &name_b, const ABResult &result);
+const char *ab_verdict_name(ABVerdict verdict);
+
+namespace benchmark_detail {
+
+bool enough_pairs(const ABResult &result, const ABOptions &options, double total_seconds);
+void print_pair(size_t pair, double seconds_a, double seconds_b);
+
+} // namespace benchmark_detail
+
+/**
+ * Compares two variants A and B of a computation: warm-up runs, then
+ * interleaved runs (A B, B A, A B, ... so that drifts in frequency,
+ * temperature or background load affect both alike) until the confidence
+ * interval of the ratio of medians is narrow enough (or the pair or time
+ * limits are reached); then a verdict from a paired bootstrap confidence
+ * interval of the ratio and a Mann-Whitney U test.
+ *
+ * The runs do not stop as soon as a difference looks significant (that
+ * would inflate false positives), only on precision or limits. The
+ * callables are timed as in benchmark (self-timing callables included).
+ *
+ * @param fn_a Variant A (baseline)
+ * @param fn_b Variant B (candidate)
+ * @param options Run limits, confidence and equivalence margin
+ * @return ABResult Statistics of both variants, ratio, interval, p-value and verdict
+ *
+ * Example:
+ *   ABResult r = benchmark_ab([] { return sum_v1(data); }, [] { return sum_v2(data); });
+ *   print_ab_result("sum_v1", "sum_v2", r); // e.g. "B is faster"
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+template <typename FnA, typename FnB>
+ABResult benchmark_ab(FnA &&fn_a, FnB &&fn_b, const ABOptions &options = ABOptions())
+{
+  std::unique_ptr<CpuPinning> pinning;
+  if (options.pin_cpu >= 0) {
+    pinning = std::make_unique<CpuPinning>(options.pin_cpu);
+  }
+
+  for (int i = 0; i < options.warmup_runs; i++) {
+    benchmark_detail::time_call(fn_a);
+    benchmark_detail::time_call(fn_b);
+  }
+
+  ABResult result;
+  double total_seconds = 0.0;
+  while (!benchmark_detail::enough_pairs(result, options, total_seconds)) {
+    double seconds_a = 0.0;
+    double seconds_b = 0.0;
+    if (result.a.durations.size() % 2 == 0) {
+      seconds_a = benchmark_detail::time_call(fn_a);
+      seconds_b = benchmark_detail::time_call(fn_b);
+    } else {
+      seconds_b = benchmark_detail::time_call(fn_b);
+      seconds_a = benchmark_detail::time_call(fn_a);
+    }
+    result.a.durations.push_back(seconds_a);
+    result.b.durations.push_back(seconds_b);
+    total_seconds += seconds_a + seconds_b;
+    if (options.verbose) {
+      benchmark_detail::print_pair(result.a.durations.size(), seconds_a, seconds_b);
+    }
+  }
+  summarize_ab(result, options);
+  result.a.pinned_cpu = result.b.pinned_cpu = (pinning && pinning->pinned()) ? options.pin_cpu : -1;
+  return result;
+}
+
+#endif // BENCHMARK_AB_HPP
@@ -0,0 +1,579 @@
+#include "benchmark_report.hpp"
+#include "csv_writer.hpp"
+#include "stopwatch.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/utsname.h>
+#include <unistd.h>
+#endif
+
+#if !defined(CPP_UTILS_CXXFLAGS)
+#define CPP_UTILS_CXXFLAGS "unknown"
+#endif
+#if !defined(CPP_UTILS_GIT_REVISION)
+#define CPP_UTILS_GIT_REVISION "unknown"
+#endif
+
+namespace {
+
+// Minimal JSON document model and parser, enough to read back the files
+// written by write_benchmark_json
+struct JsonValue {
+  enum class Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT } type = Type::NUL;
+  bool boolean = false;
+  double number = 0.0;
+  std::string string;
+  std::vector<JsonValue> items;  // array elements, or object values
+  std::vector<std::string> keys; // object keys, parallel to items
+
+  const JsonValue *find(const std::string &key) const
+  {
+    for (size_t i = 0; i < keys.size(); i++) {
+      if (keys[i] == key) {
+        return &items[i];
+      }
+    }
+    return nullptr;
+  }
+  double number_at(const std::string &key) const
+  {
+    const JsonValue *v = find(key);
+    return (v != nullptr && v->type == Type::NUMBER) ? v->number : 0.0;
+  }
+  std::string string_at(const std::string &key) const
+  {
+    const JsonValue *v = find(key);
+    return (v != nullptr && v->type == Type::STRING) ? v->string : std::string();
+  }
+};
+
+class JsonParser {
+public:
+  JsonParser(const std::string &text, const std::string &filename) : text(text), filename(filename) {}
+
+  JsonValue parse_document()
+  {
+    JsonValue value = parse_value();
+    skip_spaces();
+    if (pos != text.size()) {
+      fail("trailing characters");
+    }
+    return value;
+  }
+
+private:
+  [[noreturn]] void fail(const std::string &what) const
+  {
+    throw std::runtime_error("Invalid JSON (" + what + ") at offset " + std::to_string(pos) + " in file: " + filename);
+  }
+
+  void skip_spaces()
+  {
+    while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+      pos++;
+    }
+  }
+
+  void expect(char c)
+  {
+    skip_spaces();
+    if (pos >= text.size() || text[pos] != c) {
+      fail(std::string("expected '") + c + "'");
+    }
+    pos++;
+  }
+
+  bool consume(const char *word)
+  {
+    size_t n = std::char_traits<char>::length(word);
+    if (text.compare(pos, n, word) == 0) {
+      pos += n;
+      return true;
+    }
+    return false;
+  }
+
+  JsonValue parse_value()
+  {
+    skip_spaces();
+    if (pos >= text.size()) {
+      fail("unexpected end");
+    }
+    JsonValue value;
+    char c = text[pos];
+    if (c == '{') {
+      value.type = JsonValue::Type::OBJECT;
+      pos++;
+      skip_spaces();
+      if (pos < text.size() && text[pos] == '}') {
+        pos++;
+        return value;
+      }
+      do {
+        skip_spaces();
+        value.keys.push_back(parse_string());
+        expect(':');
+        value.items.push_back(parse_value());
+        skip_spaces();
+      } while (pos < text.size() && text[pos] == ',' && ++pos);
+      expect('}');
+    } else if (c == '[') {
+      value.type = JsonValue::Type::ARRAY;
+      pos++;
+      skip_spaces();
+      if (pos < text.size() && text[pos] == ']') {
+        pos++;
+        return value;
+      }
+      do {
+        value.items.push_back(parse_value());
+        skip_spaces();
+      } while (pos < text.size() && text[pos] == ',' && ++pos);
+      expect(']');
+    } else if (c == '"') {
+      value.type = JsonValue::Type::STRING;
+      value.string = parse_string();
+    } else if (consume("true")) {
+      value.type = JsonValue::Type::BOOLEAN;
+      value.boolean = true;
+    } else if (consume("false")) {
+      value.type = JsonValue::Type::BOOLEAN;
+    } else if (consume("null")) {
+      value.type = JsonValue::Type::NUL;
+    } else {
+      value.type = JsonValue::Type::NUMBER;
+      const char *begin = text.c_str() + pos;
+      char *end = nullptr;
+      value.number = std::strtod(begin, &end);
+      if (end == begin) {
+        fail("unexpected character");
+      }
+      pos += static_cast<size_t>(end - begin);
+    }
+    return value;
+  }
+
+  std::string parse_string()
+  {
+    if (pos >= text.size() || text[pos] != '"') {
+      fail("expected a string");
+    }
+    pos++;
+    std::string s;
+    while (pos < text.size() && text[pos] != '"') {
+      char c = text[pos++];
+      if (c == '\\' && pos < text.size()) {
+        char e = text[pos++];
+        switch (e) {
+        case 'n':
+          s += '\n';
+          break;
+        case 't':
+          s += '\t';
+          break;
+        case 'r':
+          s += '\r';
+          break;
+        case 'b':
+          s += '\b';
+          break;
+        case 'f':
+          s += '\f';
+          break;
+        case 'u':
+          if (pos + 4 > text.size()) {
+            fail("truncated escape");
+          }
+          s += static_cast<char>(std::stoi(text.substr(pos, 4), nullptr, 16)); // ASCII only
+          pos += 4;
+          break;
+        default:
+          s += e;
+        }
+      } else {
+        s += c;
+      }
+    }
+    if (pos >= text.size()) {
+      fail("unterminated string");
+    }
+    pos++;
+    return s;
+  }
+
+  const std::string &text;
+  const std::string &filename;
+  size_t pos = 0;
+};
+
+std::string first_line_with(const std::string &filename, const std::string &prefix)
+{
+  std::ifstream file(filename);
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.compare(0, prefix.size(), prefix) == 0) {
+      size_t colon = line.find(':');
+      if (colon != std::string::npos) {
+        size_t start = line.find_first_not_of(" \t", colon + 1);
+        return start == std::string::npos ? std::string() : line.substr(start);
+      }
+    }
+  }
+  return std::string();
+}
+
+// Results recorded by record_benchmark_result, written at exit
+struct SessionReport {
+  std::mutex mutex;
+  BenchmarkReport report;
+  std::string exit_filename;
+};
+
+SessionReport &session()
+{
+  static SessionReport *instance = new SessionReport();
+  return *instance;
+}
+
+void write_session_on_exit()
+{
+  SessionReport &s = session();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  try {
+    const std::string &filename = s.exit_filename;
+    if (filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".csv") == 0) {
+      write_benchmark_csv(s.report, filename);
+    } else {
+      write_benchmark_json(s.report, filename);
+    }
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+  }
+}
+
+} // namespace
+
+/**
+ * Describes the machine and build running the benchmarks: date, host, OS,
+ * CPU model and count, TSC rate, compiler, compiler flags and git revision
+ * (the last two are the macros CPP_UTILS_CXXFLAGS and
+ * CPP_UTILS_GIT_REVISION, which the Makefile defines in build/build_info.h;
+ * "unknown" otherwise).
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+BenchmarkEnvironment current_benchmark_environment()
+{
+  BenchmarkEnvironment env;
+
+  std::time_t now = std::time(nullptr);
+  std::tm utc{};
+#if defined(_WIN32)
+  gmtime_s(&utc, &now);
+#else
+  gmtime_r(&now, &utc);
+#endif
+  char date[32];
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", &utc);
+  env.date = date;
+
+#if defined(_WIN32)
+  const char *computer = std::getenv("COMPUTERNAME");
+  env.host = computer ? computer : "";
+  env.os = "Windows";
+#else
+  char host[256] = {};
+  if (::gethostname(host, sizeof(host) - 1) == 0) {
+    env.host = host;
+  }
+  struct utsname uts;
+  if (::uname(&uts) == 0) {
+    env.os = std::string(uts.sysname) + " " + uts.release + " " + uts.machine;
+  }
+#endif
+  env.cpu = first_line_with("/proc/cpuinfo", "model name");
+  env.nb_cpus = std::thread::hardware_concurrency();
+  const StopwatchCalibration &calibration = stopwatch_calibration();
+  env.tsc_ghz = calibration.uses_tsc ? calibration.ticks_per_second / 1e9 : 0.0;
+
+#if defined(__clang__)
+  env.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+  env.compiler = "g++ " __VERSION__;
+#elif defined(_MSC_VER)
+  env.compiler = "MSVC " + std::to_string(_MSC_VER);
+#else
+  env.compiler = "unknown";
+#endif
+  env.compiler_flags = CPP_UTILS_CXXFLAGS;
+  env.git_revision = CPP_UTILS_GIT_REVISION;
+  return env;
+}
+
+/**
+ * Writes benchmark results as JSON: the environment, then for each
+ * benchmark its statistics and all its durations (in seconds), which
+ * compare_benchmarks needs.
+ *
+ * @throws std::runtime_error if the file cannot be written
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+void write_benchmark_json(const BenchmarkReport &report, const std::string &filename)
+{
+  std::ofstream out(filename, std::ios::binary);
+  if (!out) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+  out << std::setprecision(std::numeric_limits<double>::max_digits10);
+  const BenchmarkEnvironment &env = report.environment;
+  out << "{\n  \"environment\": {";
+  const std::pair<const char *, const std::string *> strings[] = {
+      {"date", &env.date}, {"host", &env.host}, {"os", &env.os}, {"cpu", &env.cpu}, {"compiler", &env.compiler},
+      {"compiler_flags", &env.compiler_flags}, {"git_revision", &env.git_revision}};
+  for (const auto &[key, value] : strings) {
+    out << "\n    \"" << key << "\": ";
+    write_json_string(out, *value);
+    out << ",";
+  }
+  out << "\n    \"nb_cpus\": " << env.nb_cpus << ",\n    \"tsc_ghz\": " << env.tsc_ghz << "\n  },\n  \"benchmarks\": [";
+  for (size_t i = 0; i < report.records.size(); i++) {
+    const BenchmarkResult &r = report.records[i].result;
+    out << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+    write_json_string(out, report.records[i].name);
+    out << ", \"runs\": " << r.durations.size() << ", \"median\": " << r.median << ", \"mean\": " << r.mean
+        << ", \"stddev\": " << r.stddev << ", \"mad\": " << r.mad << ", \"min\": " << r.min << ", \"max\": " << r.max
+        << ", \"p90\": " << r.p90 << ", \"p99\": " << r.p99 << ", \"ci95\": " << r.ci95
+        << ", \"items_per_run\": " << r.items_per_run << ", \"outliers\": " << r.outliers.size()
+        << ", \"pinned_cpu\": " << r.pinned_cpu << ", \"load_average\": " << r.load_average
+        << ",\n     \"durations\": [";
+    for (size_t j = 0; j < r.durations.size(); j++) {
+      out << (j == 0 ? "" : ", ") << r.durations[j];
+    }
+    out << "]}";
+  }
+  out << "\n  ]\n}\n";
+  if (!out) {
+    throw std::runtime_error("Cannot write file: " + filename);
+  }
+}
+
+/**
+ * Writes benchmark results as CSV (',' delimiter, '.' decimal separator),
+ * one row per benchmark with the environment repeated on each row, so
+ * that files of successive sessions can be concatenated.
+ *
+ * @throws std::runtime_error if the file cannot be written
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+void write_benchmark_csv(const BenchmarkReport &report, const std::string &filename)
+{
+  CsvWriter out(filename, ',', '.');
+  for (const char *column : {"date", "git_revision", "host", "cpu", "compiler", "compiler_flags", "name", "runs",
+                             "median", "mean", "stddev", "mad", "min", "max", "p90", "p99", "ci95", "items_per_run",
+                             "outliers", "pinned_cpu", "load_average"}) {
+    out.field(column);
+  }
+  out.end_row();
+  const BenchmarkEnvironment &env = report.environment;
+  for (const BenchmarkRecord &record : report.records) {
+    const BenchmarkResult &r = record.result;
+    out.field(env.date).field(env.git_revision).field(env.host).field(env.cpu).field(env.compiler);
+    out.field(env.compiler_flags).field(record.name).field(static_cast<long long>(r.durations.size()));
+    for (double value : {r.median, r.mean, r.stddev, r.mad, r.min, r.max, r.p90, r.p99, r.ci95}) {
+      out.field(value, 9);
+    }
+    out.field(r.items_per_run, 0);
+    out.field(static_cast<long long>(r.outliers.size())).field(static_cast<long long>(r.pinned_cpu));
+    out.field(r.load_average, 2);
+    out.end_row();
+  }
+  out.flush();
+}
+
+/**
+ * Reads results written by write_benchmark_json; statistics are recomputed
+ * from the durations.
+ *
+ * @throws std::runtime_error if the file cannot be read or is not such a file
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+BenchmarkReport read_benchmark_json(const std::string &filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  const std::string text = buffer.str();
+  JsonValue root = JsonParser(text, filename).parse_document();
+
+  const JsonValue *env = root.find("environment");
+  const JsonValue *benchmarks = root.find("benchmarks");
+  if (env == nullptr || benchmarks == nullptr || benchmarks->type != JsonValue::Type::ARRAY) {
+    throw std::runtime_error("Not a benchmark result file: " + filename);
+  }
+  BenchmarkReport report;
+  report.environment.date = env->string_at("date");
+  report.environment.host = env->string_at("host");
+  report.environment.os = env->string_at("os");
+  report.environment.cpu = env->string_at("cpu");
+  report.environment.nb_cpus = static_cast<unsigned>(env->number_at("nb_cpus"));
+  report.environment.tsc_ghz = env->number_at("tsc_ghz");
+  report.environment.compiler = env->string_at("compiler");
+  report.environment.compiler_flags = env->string_at("compiler_flags");
+  report.environment.git_revision = env->string_at("git_revision");
+
+  for (const JsonValue &benchmark : benchmarks->items) {
+    std::vector<double> durations;
+    if (const JsonValue *values = benchmark.find("durations")) {
+      for (const JsonValue &value : values->items) {
+        durations.push_back(value.number);
+      }
+    }
+    BenchmarkRecord record{benchmark.string_at("name"), summarize_durations(std::move(durations))};
+    record.result.items_per_run = benchmark.number_at("items_per_run");
+    if (benchmark.find("pinned_cpu") != nullptr) {
+      record.result.pinned_cpu = static_cast<int>(benchmark.number_at("pinned_cpu"));
+      record.result.load_average = benchmark.number_at("load_average");
+    }
+    report.records.push_back(std::move(record));
+  }
+  return report;
+}
+
+/**
+ * Compares the benchmarks present in both reports, by name. A benchmark
+ * regressed if its median is slower by more than min_change (relative)
+ * and the difference of the durations is significant (Mann-Whitney U
+ * test, p-value < alpha); symmetrically for an improvement.
+ *
+ * Example:
+ *   compare_benchmarks(read_benchmark_json("old.json"), read_benchmark_json("new.json"))
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+std::vector<BenchmarkComparison> compare_benchmarks(const BenchmarkReport &baseline, const BenchmarkReport &candidate,
+                                                    double min_change, double alpha)
+{
+  std::vector<BenchmarkComparison> comparisons;
+  for (const BenchmarkRecord &c : candidate.records) {
+    auto b = std::find_if(baseline.records.begin(), baseline.records.end(),
+                          [&](const BenchmarkRecord &r) { return r.name == c.name; });
+    if (b == baseline.records.end()) {
+      continue;
+    }
+    BenchmarkComparison comparison;
+    comparison.name = c.name;
+    comparison.baseline_median = b->result.median;
+    comparison.candidate_median = c.result.median;
+    comparison.change = b->result.median > 0.0 ? c.result.median / b->result.median - 1.0 : 0.0;
+    comparison.p_value = mann_whitney_p_value(b->result.durations, c.result.durations);
+    bool significant = comparison.p_value < alpha;
+    comparison.regression = significant && comparison.change > min_change;
+    comparison.improvement = significant && comparison.change < -min_change;
+    comparisons.push_back(comparison);
+  }
+  return comparisons;
+}
+
+// Prints one line per benchmark; returns true if any regressed
+bool print_benchmark_comparison(const std::vector<BenchmarkComparison> &comparisons, std::ostream &out)
+{
+  auto flags = out.flags();
+  auto precision = out.precision();
+  bool regression = false;
+  for (const BenchmarkComparison &c : comparisons) {
+    out << std::fixed << std::setprecision(6) << c.name << ": " << c.baseline_median << " s -> " << c.candidate_median
+        << " s (" << std::showpos << std::setprecision(1) << 100.0 * c.change << std::noshowpos << " %, p = "
+        << std::setprecision(4) << c.p_value << ")"
+        << (c.regression ? " REGRESSION" : (c.improvement ? " improvement" : "")) << std::endl;
+    regression = regression || c.regression;
+  }
+  out.flags(flags);
+  out.precision(precision);
+  return regression;
+}
+
+// Adds a result to the session report written by write_benchmark_report_at_exit
+void record_benchmark_result(const std::string &name, const BenchmarkResult &result)
+{
+  SessionReport &s = session();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.report.records.push_back({name, result});
+}
+
+// Writes the recorded results to filename (JSON, or CSV if it ends with .csv) when the program exits
+void write_benchmark_report_at_exit(const std::string &filename)
+{
+  SessionReport &s = session();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  if (s.exit_filename.empty()) {
+    s.report.environment = current_benchmark_environment();
+    std::atexit(write_session_on_exit);
+  }
+  s.exit_filename = filename;
+}
+
+int SHOW_benchmark_report(void)
+{
+  std::vector<double> values(1 << 18, 1.0);
+  auto sum = [&values](size_t stride) {
+    double s = 0.0;
+    for (size_t i = 0; i < values.size(); i += stride) {
+      s += values[i];
+    }
+    return s;
+  };
+  BenchmarkOptions options;
+  options.min_runs = 20;
+  options.max_runs = 20;
+
+  BenchmarkReport baseline;
+  baseline.environment = current_benchmark_environment();
+  baseline.records.push_back({"sum", benchmark([&] { return sum(2); }, options)});
+  baseline.records.push_back({"sum (unchanged)", benchmark([&] { return sum(1); }, options)});
+
+  BenchmarkReport candidate = baseline;
+  candidate.records[0].result = benchmark([&] { return sum(1); }, options); // twice the work
+
+  const std::filesystem::path directory = std::filesystem::temp_directory_path();
+  const std::string json = (directory / "cpp_utils_benchmarks.json").string();
+  const std::string csv = (directory / "cpp_utils_benchmarks.csv").string();
+  write_benchmark_json(baseline, json);
+  write_benchmark_csv(baseline, csv);
+  BenchmarkReport reloaded = read_benchmark_json(json);
+
+  std::cout << "Environment: " << reloaded.environment.cpu << ", " << reloaded.environment.compiler << " "
+            << reloaded.environment.compiler_flags << ", revision " << reloaded.environment.git_revision << std::endl;
+  std::cout << "JSON: " << std::filesystem::file_size(json) << " bytes, CSV: " << std::filesystem::file_size(csv)
+            << " bytes" << std::endl;
+  bool regression = print_benchmark_comparison(compare_benchmarks(reloaded, candidate), std::cout);
+  std::cout << "Regression detected: " << (regression ? "yes" : "no") << std::endl;
+
+  std::filesystem::remove(json);
+  std::filesystem::remove(csv);
+  return 0;
+}
+
+// end
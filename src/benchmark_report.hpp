@@ -0,0 +1,55 @@
+#ifndef BENCHMARK_REPORT_HPP
+#define BENCHMARK_REPORT_HPP
+
+#include "benchmark.hpp"
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Where and how benchmarks ran
+struct BenchmarkEnvironment {
+  std::string date;           // ISO 8601, UTC
+  std::string host;
+  std::string os;
+  std::string cpu;
+  unsigned nb_cpus = 0;
+  double tsc_ghz = 0.0;       // 0 without invariant TSC
+  std::string compiler;
+  std::string compiler_flags; // from the Makefile (CPP_UTILS_CXXFLAGS)
+  std::string git_revision;   // from the Makefile (CPP_UTILS_GIT_REVISION)
+};
+
+struct BenchmarkRecord {
+  std::string name;
+  BenchmarkResult result;
+};
+
+// Results of a benchmark session, with its environment
+struct BenchmarkReport {
+  BenchmarkEnvironment environment;
+  std::vector<BenchmarkRecord> records;
+};
+
+struct BenchmarkComparison {
+  std::string name;
+  double baseline_median = 0.0;
+  double candidate_median = 0.0;
+  double change = 0.0;  // relative change of the median, > 0 when slower
+  double p_value = 1.0; // Mann-Whitney U test on the durations
+  bool regression = false;
+  bool improvement = false;
+};
+
+BenchmarkEnvironment current_benchmark_environment();
+void write_benchmark_json(const BenchmarkReport &report, const std::string &filename);
+void write_benchmark_csv(const BenchmarkReport &report, const std::string &filename);
+BenchmarkReport read_benchmark_json(const std::string &filename);
+std::vector<BenchmarkComparison> compare_benchmarks(const BenchmarkReport &baseline, const BenchmarkReport &candidate,
+                                                    double min_change = 0.05, double alpha = 0.01);
+bool print_benchmark_comparison(const std::vector<BenchmarkComparison> &comparisons, std::ostream &out);
+
+void record_benchmark_result(const std::string &name, const BenchmarkResult &result);
+void write_benchmark_report_at_exit(const std::string &filename);
+int SHOW_benchmark_report(void);
+
+#endif // BENCHMARK_REPORT_HPP
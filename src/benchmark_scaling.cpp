@@ -0,0 +1,280 @@
+#include "benchmark_scaling.hpp"
+#include "csv_writer.hpp"
+#include "parallelism_with_async.hpp"
+#include "parallelism_with_openmp.hpp"
+#include "parallelism_with_threads.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct KernelRegistry {
+  std::mutex mutex;
+  std::vector<ScalingKernel> kernels;
+};
+
+KernelRegistry &registry()
+{
+  static KernelRegistry instance;
+  return instance;
+}
+
+} // namespace
+
+// Adds a kernel to the registry (replacing a kernel of the same name)
+void register_scaling_kernel(const std::string &name, std::function<double(uint64_t n, int nb_threads)> run)
+{
+  KernelRegistry &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  auto it = std::find_if(r.kernels.begin(), r.kernels.end(), [&](const ScalingKernel &k) { return k.name == name; });
+  if (it != r.kernels.end()) {
+    it->run = std::move(run);
+  } else {
+    r.kernels.push_back({name, std::move(run)});
+  }
+}
+
+// Kernels registered so far, in registration order
+std::vector<ScalingKernel> registered_scaling_kernels()
+{
+  KernelRegistry &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  return r.kernels;
+}
+
+// Registers the Leibniz pi computations of the parallelism_with_* files
+void register_leibniz_scaling_kernels()
+{
+  register_scaling_kernel("std::async", leibniz_pi_with_async);
+  register_scaling_kernel("OpenMP reduction", leibniz_pi_with_openmp_reduction);
+  register_scaling_kernel("OpenMP atomic", leibniz_pi_with_openmp_atomic);
+  register_scaling_kernel("thread pool", leibniz_pi_with_threads);
+}
+
+/**
+ * Karp-Flatt metric: the serial fraction e = (1/S - 1/p) / (1 - 1/p)
+ * that explains the measured speedup S on p threads under Amdahl's law.
+ * A fraction growing with p reveals parallel overhead (synchronization,
+ * load imbalance) rather than a serial part of the work.
+ *
+ * @param speedup Measured speedup S
+ * @param nb_threads Number of threads p
+ * @return double Serial fraction, 0 when p <= 1
+ *
+ * Example:
+ *   karp_flatt_metric(3.2, 4) // 0.0833...
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+double karp_flatt_metric(double speedup, int nb_threads)
+{
+  if (nb_threads <= 1 || speedup <= 0.0) {
+    return 0.0;
+  }
+  const double p = static_cast<double>(nb_threads);
+  return (1.0 / speedup - 1.0 / p) / (1.0 - 1.0 / p);
+}
+
+/**
+ * Benchmarks each kernel over the grid of sizes and thread counts, and
+ * computes speedup, efficiency and Karp-Flatt metric against the median
+ * duration with 1 thread, for each kernel and size.
+ *
+ * @param kernels Kernels to run, e.g. registered_scaling_kernels()
+ * @param options Sizes, thread counts and benchmark options
+ * @return std::vector<ScalingPoint> By kernel, then size, then increasing thread count
+ *
+ * Example:
+ *   ScalingSweepOptions options;
+ *   options.sizes = {10'000'000, 100'000'000};
+ *   options.thread_counts = {1, 2, 4, 8};
+ *   print_scaling_table(run_scaling_sweep(registered_scaling_kernels(), options), std::cout);
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+std::vector<ScalingPoint> run_scaling_sweep(const std::vector<ScalingKernel> &kernels,
+                                            const ScalingSweepOptions &options)
+{
+  std::vector<int> thread_counts = options.thread_counts;
+  thread_counts.push_back(1);
+  std::sort(thread_counts.begin(), thread_counts.end());
+  thread_counts.erase(std::unique(thread_counts.begin(), thread_counts.end()), thread_counts.end());
+  thread_counts.erase(std::remove_if(thread_counts.begin(), thread_counts.end(), [](int t) { return t < 1; }),
+                      thread_counts.end());
+
+  std::vector<ScalingPoint> points;
+  for (const ScalingKernel &kernel : kernels) {
+    for (uint64_t n : options.sizes) {
+      double reference = 0.0;
+      for (int nb_threads : thread_counts) {
+        ScalingPoint point;
+        point.kernel = kernel.name;
+        point.n = n;
+        point.nb_threads = nb_threads;
+        point.result = benchmark([&] { return kernel.run(n, nb_threads); }, options.benchmark);
+        if (nb_threads == 1) {
+          reference = point.result.median;
+        }
+        point.speedup = point.result.median > 0.0 ? reference / point.result.median : 0.0;
+        point.efficiency = point.speedup / nb_threads;
+        point.karp_flatt = karp_flatt_metric(point.speedup, nb_threads);
+        points.push_back(std::move(point));
+      }
+    }
+  }
+  return points;
+}
+
+// Prints one line per point of the sweep
+void print_scaling_table(const std::vector<ScalingPoint> &points, std::ostream &out)
+{
+  auto flags = out.flags();
+  auto precision = out.precision();
+  out << std::left << std::setw(18) << "kernel" << std::right << std::setw(12) << "n" << std::setw(8) << "threads"
+      << std::setw(12) << "median (s)" << std::setw(10) << "+/- (%)" << std::setw(9) << "speedup" << std::setw(11)
+      << "efficiency" << std::setw(12) << "Karp-Flatt" << std::endl;
+  out << std::fixed;
+  for (const ScalingPoint &p : points) {
+    const double relative_ci = p.result.mean > 0.0 ? 100.0 * p.result.ci95 / p.result.mean : 0.0;
+    out << std::left << std::setw(18) << p.kernel << std::right << std::setw(12) << p.n << std::setw(8)
+        << p.nb_threads << std::setprecision(6) << std::setw(12) << p.result.median << std::setprecision(1)
+        << std::setw(10) << relative_ci << std::setprecision(2) << std::setw(9) << p.speedup << std::setw(11)
+        << p.efficiency;
+    if (p.nb_threads > 1) {
+      out << std::setprecision(3) << std::setw(12) << p.karp_flatt;
+    }
+    out << std::endl;
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
+
+/**
+ * Writes the points of a sweep as CSV (',' delimiter, '.' decimal
+ * separator), one row per point, to be loaded in a spreadsheet or a
+ * plotting tool.
+ *
+ * @throws std::runtime_error if the file cannot be written
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+void write_scaling_csv(const std::vector<ScalingPoint> &points, const std::string &filename)
+{
+  CsvWriter out(filename, ',', '.');
+  for (const char *column :
+       {"kernel", "n", "threads", "runs", "median", "mean", "ci95", "speedup", "efficiency", "karp_flatt"}) {
+    out.field(column);
+  }
+  out.end_row();
+  for (const ScalingPoint &p : points) {
+    out.field(p.kernel).field(static_cast<long long>(p.n)).field(static_cast<long long>(p.nb_threads));
+    out.field(static_cast<long long>(p.result.durations.size()));
+    out.field(p.result.median, 9).field(p.result.mean, 9).field(p.result.ci95, 9);
+    out.field(p.speedup, 4).field(p.efficiency, 4).field(p.karp_flatt, 4);
+    out.end_row();
+  }
+  out.flush();
+}
+
+/**
+ * Writes a self-contained gnuplot script (data inline) plotting speedup
+ * and efficiency against the number of threads, one curve per kernel and
+ * size, with the ideal speedup; `gnuplot filename` renders it as a PNG.
+ *
+ * @param points Points of a sweep
+ * @param filename Path to the script
+ * @param image_filename Path to the PNG written by the script
+ * @throws std::runtime_error if the file cannot be written
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+void write_scaling_gnuplot(const std::vector<ScalingPoint> &points, const std::string &filename,
+                           const std::string &image_filename)
+{
+  std::ofstream out(filename, std::ios::binary);
+  if (!out) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+  // One data block per curve, i.e. per run of consecutive points of the same kernel and size
+  std::vector<std::string> titles;
+  int max_threads = 1;
+  for (size_t i = 0; i < points.size(); i++) {
+    const ScalingPoint &p = points[i];
+    if (i == 0 || p.kernel != points[i - 1].kernel || p.n != points[i - 1].n) {
+      if (i > 0) {
+        out << "EOD\n";
+      }
+      out << "$curve" << titles.size() << " << EOD\n";
+      titles.push_back(p.kernel + ", n = " + std::to_string(p.n));
+    }
+    out << p.nb_threads << " " << p.speedup << " " << p.efficiency << "\n";
+    max_threads = std::max(max_threads, p.nb_threads);
+  }
+  if (!points.empty()) {
+    out << "EOD\n";
+  }
+
+  out << "set terminal pngcairo size 1400,600\n"
+      << "set output '" << image_filename << "'\n"
+      << "set multiplot layout 1,2\n"
+      << "set xlabel 'threads'\n"
+      << "set xrange [1:" << max_threads << "]\n"
+      << "set key left top\n"
+      << "set grid\n";
+  auto plot = [&](const char *ylabel, int column, const char *ideal) {
+    out << "set ylabel '" << ylabel << "'\n"
+        << "plot " << ideal << " title 'ideal' with lines dashtype 2";
+    for (size_t c = 0; c < titles.size(); c++) {
+      std::string title = titles[c];
+      std::replace(title.begin(), title.end(), '\'', '"');
+      out << ", \\\n     $curve" << c << " using 1:" << column << " title '" << title << "' with linespoints";
+    }
+    out << "\n";
+  };
+  plot("speedup", 2, "x");
+  out << "set yrange [0:1.1]\n";
+  plot("efficiency", 3, "1");
+  out << "unset multiplot\n";
+  if (!out) {
+    throw std::runtime_error("Cannot write file: " + filename);
+  }
+}
+
+int SHOW_benchmark_scaling(void)
+{
+  register_leibniz_scaling_kernels();
+
+  ScalingSweepOptions options;
+  options.sizes = {10'000'000, 100'000'000};
+  options.thread_counts = {1, 2, 4, static_cast<int>(std::thread::hardware_concurrency())};
+  options.benchmark.min_runs = 3;
+  options.benchmark.max_runs = 10;
+  options.benchmark.max_seconds = 2.0;
+  options.benchmark.target_relative_ci = 0.02;
+
+  std::vector<ScalingPoint> points = run_scaling_sweep(registered_scaling_kernels(), options);
+  print_scaling_table(points, std::cout);
+
+  const std::filesystem::path directory = std::filesystem::temp_directory_path();
+  const std::string csv = (directory / "cpp_utils_scaling.csv").string();
+  const std::string script = (directory / "cpp_utils_scaling.gp").string();
+  write_scaling_csv(points, csv);
+  write_scaling_gnuplot(points, script, (directory / "cpp_utils_scaling.png").string());
+  std::cout << "CSV: " << std::filesystem::file_size(csv) << " bytes, gnuplot script: "
+            << std::filesystem::file_size(script) << " bytes" << std::endl;
+
+  std::filesystem::remove(csv);
+  std::filesystem::remove(script);
+  return 0;
+}
+
+// end
@@ -0,0 +1,48 @@
+#ifndef BENCHMARK_SCALING_HPP
+#define BENCHMARK_SCALING_HPP
+
+#include "benchmark.hpp"
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// A computation of size n on nb_threads threads; the returned value is
+// passed to do_not_optimize
+struct ScalingKernel {
+  std::string name;
+  std::function<double(uint64_t n, int nb_threads)> run;
+};
+
+struct ScalingSweepOptions {
+  std::vector<uint64_t> sizes;
+  std::vector<int> thread_counts; // 1 is added if missing: it is the reference of the speedup
+  BenchmarkOptions benchmark;     // for each point of the grid
+};
+
+// Result of one kernel, size and thread count
+struct ScalingPoint {
+  std::string kernel;
+  uint64_t n = 0;
+  int nb_threads = 1;
+  BenchmarkResult result;
+  double speedup = 1.0;    // median with 1 thread / median with nb_threads
+  double efficiency = 1.0; // speedup / nb_threads
+  double karp_flatt = 0.0; // experimentally determined serial fraction (0 with 1 thread)
+};
+
+void register_scaling_kernel(const std::string &name, std::function<double(uint64_t n, int nb_threads)> run);
+std::vector<ScalingKernel> registered_scaling_kernels();
+void register_leibniz_scaling_kernels();
+
+double karp_flatt_metric(double speedup, int nb_threads);
+std::vector<ScalingPoint> run_scaling_sweep(const std::vector<ScalingKernel> &kernels,
+                                            const ScalingSweepOptions &options);
+void print_scaling_table(const std::vector<ScalingPoint> &points, std::ostream &out);
+void write_scaling_csv(const std::vector<ScalingPoint> &points, const std::string &filename);
+void write_scaling_gnuplot(const std::vector<ScalingPoint> &points, const std::string &filename,
+                           const std::string &image_filename);
+int SHOW_benchmark_scaling(void);
+
+#endif // BENCHMARK_SCALING_HPP
@@ -0,0 +1,433 @@
+#include "columnar_dataset.hpp"
+#include "csv_reader.hpp"
+#include "csv_writer.hpp"
+#include "dates_and_times.hpp"
+#include "segmented_column.hpp"
+#include "trace.hpp"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr char MAGIC[8] = {'C', 'P', 'P', 'U', 'C', 'O', 'L', 'S'};
+constexpr uint32_t VERSION = 1;
+constexpr size_t ALIGNMENT = 64;
+
+// Layout: SegmentHeader, nb_columns ColumnDescriptor, then the column arrays, each 64-byte aligned
+struct SegmentHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t ready; // set to 1 (release) once the data is filled
+  uint64_t nb_rows;
+  uint64_t nb_columns;
+  uint64_t total_size;
+};
+
+struct ColumnDescriptor {
+  char name[32];
+  uint32_t type;
+  uint32_t element_size;
+  uint64_t offset;
+};
+
+size_t align_up(size_t n)
+{
+  return (n + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+size_t layout_size(const std::vector<ColumnSpec> &columns, size_t nb_rows)
+{
+  size_t offset = align_up(sizeof(SegmentHeader) + columns.size() * sizeof(ColumnDescriptor));
+  for (size_t i = 0; i < columns.size(); i++) {
+    offset = align_up(offset + nb_rows * 8);
+  }
+  return offset;
+}
+
+void write_layout(char *base, const std::vector<ColumnSpec> &columns, size_t nb_rows)
+{
+  SegmentHeader header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.ready = 0;
+  header.nb_rows = nb_rows;
+  header.nb_columns = columns.size();
+  header.total_size = layout_size(columns, nb_rows);
+  std::memcpy(base, &header, sizeof(header));
+
+  size_t offset = align_up(sizeof(SegmentHeader) + columns.size() * sizeof(ColumnDescriptor));
+  for (size_t i = 0; i < columns.size(); i++) {
+    if (columns[i].name.size() >= sizeof(ColumnDescriptor::name)) {
+      throw std::invalid_argument("Column name too long: " + columns[i].name);
+    }
+    ColumnDescriptor descriptor{};
+    std::memcpy(descriptor.name, columns[i].name.data(), columns[i].name.size());
+    descriptor.type = static_cast<uint32_t>(columns[i].type);
+    descriptor.element_size = 8;
+    descriptor.offset = offset;
+    std::memcpy(base + sizeof(SegmentHeader) + i * sizeof(ColumnDescriptor), &descriptor, sizeof(descriptor));
+    offset = align_up(offset + nb_rows * 8);
+  }
+}
+
+const SegmentHeader *header_of(const char *base)
+{
+  return reinterpret_cast<const SegmentHeader *>(base);
+}
+
+const ColumnDescriptor *descriptor_of(const char *base, size_t i)
+{
+  return reinterpret_cast<const ColumnDescriptor *>(base + sizeof(SegmentHeader)) + i;
+}
+
+// Checks that an attached segment is a complete dataset that fits in `length` bytes
+void validate_layout(const char *base, size_t length, const std::string &name)
+{
+  const SegmentHeader *header = header_of(base);
+  if (length < sizeof(SegmentHeader) || std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION) {
+    throw std::runtime_error("Not a columnar dataset: " + name);
+  }
+  if (__atomic_load_n(&header->ready, __ATOMIC_ACQUIRE) != 1) {
+    throw std::runtime_error("Shared dataset not ready: " + name);
+  }
+  if (header->total_size > length || header->nb_columns > (length - sizeof(SegmentHeader)) / sizeof(ColumnDescriptor)) {
+    throw std::runtime_error("Truncated columnar dataset: " + name);
+  }
+  for (size_t i = 0; i < header->nb_columns; i++) {
+    const ColumnDescriptor *descriptor = descriptor_of(base, i);
+    if (descriptor->element_size != 8 || descriptor->offset % ALIGNMENT != 0 || descriptor->offset > length ||
+        header->nb_rows > (length - descriptor->offset) / 8) {
+      throw std::runtime_error("Corrupted columnar dataset: " + name);
+    }
+  }
+}
+
+} // namespace
+
+/**
+ * Creates a dataset in local memory, with the given columns and number of
+ * rows; values are zero-initialized.
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+ColumnarDataset::ColumnarDataset(const std::vector<ColumnSpec> &columns, size_t nb_rows)
+{
+  length = layout_size(columns, nb_rows);
+  base = static_cast<char *>(::operator new(length, std::align_val_t(ALIGNMENT)));
+  std::memset(base, 0, length);
+  try {
+    write_layout(base, columns, nb_rows);
+  } catch (...) {
+    release();
+    throw;
+  }
+  reinterpret_cast<SegmentHeader *>(base)->ready = 1;
+}
+
+/**
+ * Creates a dataset in a new named POSIX shared-memory segment (shm_open +
+ * mmap), to be filled then sealed (see seal) by this process, and attached
+ * read-only by others (see attach_shared). The segment outlives the
+ * process until remove_shared.
+ *
+ * @param name Segment name, e.g. "/eurusd_m1"
+ * @param columns The columns
+ * @param nb_rows Number of rows
+ * @return ColumnarDataset The writable dataset
+ * @throws std::runtime_error if the segment already exists or cannot be created (or on Windows)
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+ColumnarDataset ColumnarDataset::create_shared(const std::string &name, const std::vector<ColumnSpec> &columns, size_t nb_rows)
+{
+#if defined(_WIN32)
+  (void)columns;
+  (void)nb_rows;
+  throw std::runtime_error("POSIX shared memory is not available: " + name);
+#else
+  ColumnarDataset dataset;
+  dataset.length = layout_size(columns, nb_rows);
+  int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    throw std::runtime_error((errno == EEXIST ? "Shared dataset already exists: " : "Cannot create shared dataset: ") + name);
+  }
+  void *p = MAP_FAILED;
+  if (::ftruncate(fd, static_cast<off_t>(dataset.length)) == 0) {
+    p = ::mmap(nullptr, dataset.length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  ::close(fd);
+  if (p == MAP_FAILED) {
+    ::shm_unlink(name.c_str());
+    throw std::runtime_error("Cannot map shared dataset: " + name);
+  }
+  dataset.base = static_cast<char *>(p);
+  dataset.shared = true;
+  try {
+    write_layout(dataset.base, columns, nb_rows);
+  } catch (...) {
+    ::shm_unlink(name.c_str());
+    throw;
+  }
+  return dataset;
+#endif
+}
+
+/**
+ * Attaches, read-only, to a sealed dataset published in a named POSIX
+ * shared-memory segment. Only the mapping is created: no data is copied,
+ * and the pages are shared with the other processes.
+ *
+ * @param name Segment name, e.g. "/eurusd_m1"
+ * @return ColumnarDataset The read-only dataset
+ * @throws std::runtime_error if the segment does not exist, is not sealed, or is not a valid dataset
+ *
+ * Example:
+ *   ColumnarDataset d = ColumnarDataset::attach_shared("/eurusd_m1");
+ *   const double *close = d.column<double>(d.column_index("close"));
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+ColumnarDataset ColumnarDataset::attach_shared(const std::string &name)
+{
+#if defined(_WIN32)
+  throw std::runtime_error("POSIX shared memory is not available: " + name);
+#else
+  int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open shared dataset: " + name);
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+    ::close(fd);
+    throw std::runtime_error("Not a columnar dataset: " + name);
+  }
+  ColumnarDataset dataset;
+  dataset.length = static_cast<size_t>(st.st_size);
+  void *p = ::mmap(nullptr, dataset.length, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED) {
+    throw std::runtime_error("Cannot map shared dataset: " + name);
+  }
+  dataset.base = static_cast<char *>(p);
+  dataset.shared = true;
+  dataset.read_only = true;
+  validate_layout(dataset.base, dataset.length, name); // dataset unmaps on throw
+  return dataset;
+#endif
+}
+
+/**
+ * Removes a named shared-memory segment; processes still attached keep their mapping.
+ *
+ * @return bool true if the segment existed
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+bool ColumnarDataset::remove_shared(const std::string &name)
+{
+#if defined(_WIN32)
+  (void)name;
+  return false;
+#else
+  return ::shm_unlink(name.c_str()) == 0;
+#endif
+}
+
+ColumnarDataset::~ColumnarDataset()
+{
+  release();
+}
+
+ColumnarDataset::ColumnarDataset(ColumnarDataset &&other) noexcept
+    : base(std::exchange(other.base, nullptr)), length(std::exchange(other.length, 0)), shared(other.shared),
+      read_only(other.read_only)
+{
+}
+
+ColumnarDataset &ColumnarDataset::operator=(ColumnarDataset &&other) noexcept
+{
+  if (this != &other) {
+    release();
+    base = std::exchange(other.base, nullptr);
+    length = std::exchange(other.length, 0);
+    shared = other.shared;
+    read_only = other.read_only;
+  }
+  return *this;
+}
+
+void ColumnarDataset::release()
+{
+  if (base == nullptr) {
+    return;
+  }
+#if !defined(_WIN32)
+  if (shared) {
+    ::munmap(base, length);
+    base = nullptr;
+    return;
+  }
+#endif
+  ::operator delete(base, std::align_val_t(ALIGNMENT));
+  base = nullptr;
+}
+
+void ColumnarDataset::seal()
+{
+  if (read_only) {
+    throw std::logic_error("Dataset is attached read-only");
+  }
+  __atomic_store_n(&reinterpret_cast<SegmentHeader *>(base)->ready, 1u, __ATOMIC_RELEASE);
+}
+
+size_t ColumnarDataset::nb_rows() const
+{
+  return header_of(base)->nb_rows;
+}
+
+size_t ColumnarDataset::nb_columns() const
+{
+  return header_of(base)->nb_columns;
+}
+
+std::string ColumnarDataset::column_name(size_t i) const
+{
+  if (i >= nb_columns()) {
+    throw std::out_of_range("Column index out of range");
+  }
+  const char *name = descriptor_of(base, i)->name;
+  return std::string(name, strnlen(name, sizeof(ColumnDescriptor::name)));
+}
+
+ColumnType ColumnarDataset::column_type(size_t i) const
+{
+  if (i >= nb_columns()) {
+    throw std::out_of_range("Column index out of range");
+  }
+  return static_cast<ColumnType>(descriptor_of(base, i)->type);
+}
+
+size_t ColumnarDataset::column_index(std::string_view name) const
+{
+  for (size_t i = 0; i < nb_columns(); i++) {
+    if (column_name(i) == name) {
+      return i;
+    }
+  }
+  throw std::invalid_argument("No such column: " + std::string(name));
+}
+
+const void *ColumnarDataset::column_data(size_t i, ColumnType type) const
+{
+  if (column_type(i) != type) {
+    throw std::invalid_argument("Wrong type for column: " + column_name(i));
+  }
+  return base + descriptor_of(base, i)->offset;
+}
+
+/**
+ * Loads an OHLCV CSV file into a columnar dataset (columns time_ms, open,
+ * high, low, close, volume), in local memory, or, if shared_name is not
+ * empty, published in a shared-memory segment for other processes.
+ *
+ * The same loader fills either kind of storage: the file is read in a
+ * single pass into segmented columns (read_ohlcv_segmented), then copied
+ * into the dataset once its size is known, and the dataset is sealed.
+ *
+ * @param filename Path to the CSV file (dialect sniffed)
+ * @param shared_name Shared-memory segment name (e.g. "/eurusd_m1"), or empty for local memory
+ * @return ColumnarDataset The sealed, writable dataset
+ * @throws same as read_ohlcv_segmented and ColumnarDataset::create_shared
+ *
+ * Example:
+ *   process A: ColumnarDataset d = load_ohlcv_dataset("EURUSD.csv", "/eurusd_m1");
+ *   process B: ColumnarDataset d = ColumnarDataset::attach_shared("/eurusd_m1");
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+ColumnarDataset load_ohlcv_dataset(const std::string &filename, const std::string &shared_name)
+{
+  TRACE_SCOPE("load_ohlcv_dataset");
+  const OhlcvSegmentedColumns bars = read_ohlcv_segmented(filename);
+  const std::vector<ColumnSpec> columns = {{"time_ms", ColumnType::INT64}, {"open", ColumnType::DOUBLE},
+                                           {"high", ColumnType::DOUBLE},   {"low", ColumnType::DOUBLE},
+                                           {"close", ColumnType::DOUBLE},  {"volume", ColumnType::DOUBLE}};
+  const size_t n = bars.time.size();
+  ColumnarDataset dataset = shared_name.empty() ? ColumnarDataset(columns, n)
+                                                : ColumnarDataset::create_shared(shared_name, columns, n);
+
+  int64_t *time_ms = dataset.mutable_column<int64_t>(0);
+  bars.time.for_each_block([&time_ms](const std::chrono::system_clock::time_point *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+      *time_ms++ = std::chrono::duration_cast<std::chrono::milliseconds>(data[i].time_since_epoch()).count();
+    }
+  });
+  bars.open.copy_to(dataset.mutable_column<double>(1));
+  bars.high.copy_to(dataset.mutable_column<double>(2));
+  bars.low.copy_to(dataset.mutable_column<double>(3));
+  bars.close.copy_to(dataset.mutable_column<double>(4));
+  bars.volume.copy_to(dataset.mutable_column<double>(5));
+  dataset.seal();
+  return dataset;
+}
+
+int SHOW_shared_dataset(void)
+{
+  const std::string filename = (std::filesystem::temp_directory_path() / "cpp_utils_dataset.csv").string();
+  const std::string shared_name = "/cpp_utils_show_dataset";
+  {
+    CsvWriter writer(filename, ';', ',');
+    writer.field("Gmt time").field("Open").field("High").field("Low").field("Close").field("Volume");
+    writer.end_row();
+    const auto tp0 = parse_date_time_UTC("01.02.2013 00:00:00.000");
+    for (int i = 0; i < 200'000; i++) {
+      double price = 1.36115 + (i % 1000) * 1e-5;
+      writer.field(tp0 + std::chrono::minutes(i)).field(price, 5).field(price, 5).field(price, 5).field(price, 5).field(1.0, 2);
+      writer.end_row();
+    }
+  }
+  ColumnarDataset::remove_shared(shared_name); // leftover of an interrupted run
+
+  auto start = std::chrono::steady_clock::now();
+  ColumnarDataset published = load_ohlcv_dataset(filename, shared_name);
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> load_duration = end - start;
+
+  // What another process would do
+  start = std::chrono::steady_clock::now();
+  ColumnarDataset attached = ColumnarDataset::attach_shared(shared_name);
+  end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> attach_duration = end - start;
+
+  const double *close = attached.column<double>(attached.column_index("close"));
+  double sum = 0.0;
+  for (size_t i = 0; i < attached.nb_rows(); i++) {
+    sum += close[i];
+  }
+
+  std::cout << "load_ohlcv_dataset (publish): " << published.nb_rows() << " rows, " << published.byte_size() / 1024
+            << " KB (in " << load_duration.count() << " s)" << std::endl;
+  std::cout << "attach_shared: " << attached.nb_rows() << " rows, sum of closes " << sum << " (in "
+            << attach_duration.count() * 1000 << " ms)" << std::endl;
+
+  ColumnarDataset::remove_shared(shared_name);
+  std::filesystem::remove(filename);
+  return 0;
+}
+
+// end
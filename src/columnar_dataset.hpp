@@ -0,0 +1,84 @@
+#ifndef COLUMNAR_DATASET_HPP
+#define COLUMNAR_DATASET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+enum class ColumnType : uint32_t { INT64 = 1, DOUBLE = 2 };
+
+struct ColumnSpec {
+  std::string name; // at most 31 characters
+  ColumnType type;
+};
+
+// Fixed-size columns in one self-describing memory block (header, column
+// table, 64-byte aligned column arrays), in local memory or in a named
+// POSIX shared-memory segment
+class ColumnarDataset {
+public:
+  ColumnarDataset(const std::vector<ColumnSpec> &columns, size_t nb_rows);
+  static ColumnarDataset create_shared(const std::string &name, const std::vector<ColumnSpec> &columns, size_t nb_rows);
+  static ColumnarDataset attach_shared(const std::string &name);
+  static bool remove_shared(const std::string &name);
+
+  ~ColumnarDataset();
+  ColumnarDataset(ColumnarDataset &&other) noexcept;
+  ColumnarDataset &operator=(ColumnarDataset &&other) noexcept;
+  ColumnarDataset(const ColumnarDataset &) = delete;
+  ColumnarDataset &operator=(const ColumnarDataset &) = delete;
+
+  size_t nb_rows() const;
+  size_t nb_columns() const;
+  std::string column_name(size_t i) const;
+  ColumnType column_type(size_t i) const;
+  size_t column_index(std::string_view name) const;
+  size_t byte_size() const { return length; }
+  bool is_shared() const { return shared; }
+  bool is_read_only() const { return read_only; }
+
+  // Makes a shared dataset visible to attach_shared, once filled
+  void seal();
+
+  template <typename T>
+  const T *column(size_t i) const
+  {
+    return static_cast<const T *>(column_data(i, type_of<T>()));
+  }
+
+  // Writable access, for datasets in local memory or created by this process
+  template <typename T>
+  T *mutable_column(size_t i)
+  {
+    if (read_only) {
+      throw std::logic_error("Dataset is attached read-only");
+    }
+    return static_cast<T *>(const_cast<void *>(column_data(i, type_of<T>())));
+  }
+
+private:
+  ColumnarDataset() = default;
+  const void *column_data(size_t i, ColumnType type) const;
+  void release();
+
+  template <typename T>
+  static constexpr ColumnType type_of()
+  {
+    static_assert(std::is_same_v<T, int64_t> || std::is_same_v<T, double>, "Columns are int64_t or double");
+    return std::is_same_v<T, int64_t> ? ColumnType::INT64 : ColumnType::DOUBLE;
+  }
+
+  char *base = nullptr;
+  size_t length = 0;
+  bool shared = false;
+  bool read_only = false;
+};
+
+ColumnarDataset load_ohlcv_dataset(const std::string &filename, const std::string &shared_name = std::string());
+int SHOW_shared_dataset(void);
+
+#endif // COLUMNAR_DATASET_HPP
@@ -0,0 +1,714 @@
+#include "csv_external_sort.hpp"
+#include "csv_reader.hpp"
+#include "dates_and_times.hpp"
+#include "files_block_reader.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct RunEntry {
+  int64_t key;     // epoch milliseconds
+  uint32_t offset; // of the row in Run::rows
+  uint32_t length; // without '\n'
+};
+
+// Stable LSD radix sort on the signed 64-bit keys, 8 bits per pass; passes
+// on bytes that all keys share (e.g. the high bytes of timestamps) are skipped
+void radix_sort(std::vector<RunEntry> &entries, std::vector<RunEntry> &scratch)
+{
+  const size_t n = entries.size();
+  if (n < 2) {
+    return;
+  }
+  scratch.resize(n);
+
+  std::vector<size_t> counts(8 * 256, 0);
+  for (const RunEntry &entry : entries) {
+    uint64_t key = static_cast<uint64_t>(entry.key) ^ (1ULL << 63);
+    for (int b = 0; b < 8; b++) {
+      counts[b * 256 + ((key >> (8 * b)) & 0xFF)]++;
+    }
+  }
+
+  RunEntry *src = entries.data();
+  RunEntry *dst = scratch.data();
+  for (int b = 0; b < 8; b++) {
+    size_t *count = counts.data() + b * 256;
+    uint64_t first = static_cast<uint64_t>(src[0].key) ^ (1ULL << 63);
+    if (count[(first >> (8 * b)) & 0xFF] == n) {
+      continue;
+    }
+    size_t position = 0;
+    for (int v = 0; v < 256; v++) {
+      size_t c = count[v];
+      count[v] = position;
+      position += c;
+    }
+    for (size_t i = 0; i < n; i++) {
+      uint64_t key = static_cast<uint64_t>(src[i].key) ^ (1ULL << 63);
+      dst[count[(key >> (8 * b)) & 0xFF]++] = src[i];
+    }
+    std::swap(src, dst);
+  }
+  if (src != entries.data()) {
+    entries.swap(scratch);
+  }
+}
+
+// Rows of one run, as read, with their sort keys. The buffers are reserved
+// once and never grow: half the capacity for the rows, half for their
+// entries (and the scratch copy of the radix sort)
+struct Run {
+  std::string rows;
+  std::vector<RunEntry> entries;
+  std::vector<RunEntry> scratch;
+  size_t max_row_bytes = 0;
+  size_t max_entries = 0;
+
+  void reserve(size_t capacity)
+  {
+    if (max_entries > 0) {
+      return;
+    }
+    max_entries = capacity / 2 / (2 * sizeof(RunEntry));
+    max_row_bytes = capacity - max_entries * 2 * sizeof(RunEntry);
+    rows.reserve(max_row_bytes);
+    entries.reserve(max_entries);
+    scratch.reserve(max_entries);
+  }
+
+  bool fits(size_t length) const { return rows.size() + length <= max_row_bytes && entries.size() < max_entries; }
+
+  // Bytes held by the buffers
+  size_t footprint() const { return rows.capacity() + (entries.capacity() + scratch.capacity()) * sizeof(RunEntry); }
+};
+
+std::FILE *open_file(const std::string &filename, const char *mode)
+{
+  std::FILE *file = std::fopen(filename.c_str(), mode);
+  if (file == nullptr) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+  return file;
+}
+
+// Sorted run file: records (int64 key, uint32 length, row bytes), in key order
+void write_run(const Run &run, const std::string &filename)
+{
+  std::FILE *file = open_file(filename, "wb");
+  std::vector<char> buffer(1 << 20);
+  std::setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+  bool ok = true;
+  for (const RunEntry &entry : run.entries) {
+    ok = ok && std::fwrite(&entry.key, sizeof(entry.key), 1, file) == 1;
+    ok = ok && std::fwrite(&entry.length, sizeof(entry.length), 1, file) == 1;
+    ok = ok && std::fwrite(run.rows.data() + entry.offset, 1, entry.length, file) == entry.length;
+  }
+  ok = (std::fclose(file) == 0) && ok;
+  if (!ok) {
+    throw std::runtime_error("Cannot write file: " + filename);
+  }
+}
+
+// Sorts and spills runs on worker threads, while the caller fills the next
+// run; at most nb_threads + 1 runs are in memory.
+class RunSpiller {
+public:
+  RunSpiller(int nb_threads, size_t run_capacity, const std::string &prefix)
+      : prefix(prefix), run_capacity(run_capacity)
+  {
+    for (int i = 0; i <= nb_threads; i++) {
+      runs.push_back(std::make_unique<Run>());
+      free_runs.push_back(runs.back().get());
+    }
+    for (int i = 0; i < nb_threads; i++) {
+      workers.emplace_back([this] { work(); });
+    }
+  }
+
+  ~RunSpiller()
+  {
+    stop_workers();
+    for (const std::string &path : paths) {
+      std::error_code ec;
+      std::filesystem::remove(path, ec);
+    }
+  }
+
+  RunSpiller(const RunSpiller &) = delete;
+  RunSpiller &operator=(const RunSpiller &) = delete;
+
+  Run *acquire()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this] { return !free_runs.empty() || error; });
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    Run *run = free_runs.front();
+    free_runs.pop_front();
+    lock.unlock();
+    run->reserve(run_capacity); // on first use only: small inputs reserve a single run
+    return run;
+  }
+
+  void submit(Run *run)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    paths.push_back(prefix + std::to_string(paths.size()) + ".run");
+    queue.push_back({run, paths.back()});
+    cond.notify_all();
+  }
+
+  // Path of a new run file, e.g. of a merge pass, removed along with the others
+  std::string new_path()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    paths.push_back(prefix + std::to_string(paths.size()) + ".run");
+    return paths.back();
+  }
+
+  void release(Run *run)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    free_runs.push_back(run);
+    cond.notify_all();
+  }
+
+  // Largest footprint of a run so far (buffers never shrink: the peak)
+  size_t peak_run_bytes() const
+  {
+    size_t peak = 0;
+    for (const auto &run : runs) {
+      peak = std::max(peak, run->footprint());
+    }
+    return peak;
+  }
+
+  // Waits for all runs to be spilled; returns their files, in submission order
+  const std::vector<std::string> &finish()
+  {
+    stop_workers();
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    return paths;
+  }
+
+private:
+  struct Job {
+    Run *run;
+    std::string path;
+  };
+
+  void work()
+  {
+    set_trace_thread_name("sort worker");
+    while (true) {
+      Job job;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this] { return !queue.empty() || stopping; });
+        if (queue.empty()) {
+          return;
+        }
+        job = queue.front();
+        queue.pop_front();
+      }
+      try {
+        TRACE_SCOPE("sort and spill run");
+        radix_sort(job.run->entries, job.run->scratch);
+        write_run(*job.run, job.path);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+      job.run->rows.clear();
+      job.run->entries.clear();
+      release(job.run);
+    }
+  }
+
+  void stop_workers()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    cond.notify_all();
+    for (std::thread &worker : workers) {
+      worker.join();
+    }
+    workers.clear();
+  }
+
+  std::string prefix;
+  size_t run_capacity;
+  std::vector<std::unique_ptr<Run>> runs;
+  std::deque<Run *> free_runs;
+  std::deque<Job> queue;
+  std::vector<std::string> paths;
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool stopping = false;
+  std::exception_ptr error;
+};
+
+// Sequential reader of a run file
+class RunReader {
+public:
+  RunReader(const std::string &filename, size_t buffer_size) : buffer(buffer_size)
+  {
+    file = open_file(filename, "rb");
+    std::setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+#if defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(::fileno(file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    next();
+  }
+
+  ~RunReader() { std::fclose(file); }
+
+  RunReader(const RunReader &) = delete;
+  RunReader &operator=(const RunReader &) = delete;
+
+  // Loads the next record; done is set at end of file
+  void next()
+  {
+    uint32_t length;
+    if (std::fread(&key, sizeof(key), 1, file) != 1 || std::fread(&length, sizeof(length), 1, file) != 1) {
+      done = true;
+      return;
+    }
+    row.resize(length);
+    if (std::fread(row.data(), 1, length, file) != length) {
+      throw std::runtime_error("Truncated run file");
+    }
+  }
+
+  int64_t key = 0;
+  std::string row;
+  bool done = false;
+
+private:
+  std::vector<char> buffer;
+  std::FILE *file = nullptr;
+};
+
+// Tournament tree of losers over k runs: tree[0] is the run holding the
+// smallest key; replaying a run after it advances costs log2(k) comparisons.
+// Ties go to the lower run index, which keeps the merge stable.
+class LoserTree {
+public:
+  explicit LoserTree(const std::vector<std::unique_ptr<RunReader>> &runs) : runs(runs), k(static_cast<int>(runs.size()))
+  {
+    tree.assign(std::max(k, 1), k); // k = sentinel, before everything
+    for (int leaf = 0; leaf < k; leaf++) {
+      replay(leaf);
+    }
+  }
+
+  int winner() const { return tree[0]; }
+
+  void replay(int leaf)
+  {
+    int winner = leaf;
+    for (int node = (leaf + k) / 2; node > 0; node /= 2) {
+      if (before(tree[node], winner)) {
+        std::swap(tree[node], winner);
+      }
+    }
+    tree[0] = winner;
+  }
+
+private:
+  bool before(int a, int b) const
+  {
+    if (a == k || b == k) {
+      return a == k && b != k;
+    }
+    const RunReader &x = *runs[a];
+    const RunReader &y = *runs[b];
+    if (x.done || y.done) {
+      return !x.done;
+    }
+    return x.key < y.key || (x.key == y.key && a < b);
+  }
+
+  const std::vector<std::unique_ptr<RunReader>> &runs;
+  int k;
+  std::vector<int> tree;
+};
+
+// Buffered writer whose buffers are written by a background thread
+// (double-buffering), so that merging overlaps with output I/O
+class AsyncWriter {
+public:
+  AsyncWriter(const std::string &filename, size_t buffer_size) : filename(filename), capacity(buffer_size)
+  {
+    file = open_file(filename, "wb");
+    current.reserve(capacity);
+    pending.reserve(capacity);
+    writer = std::thread([this] { work(); });
+  }
+
+  ~AsyncWriter()
+  {
+    stop();
+    if (file != nullptr) {
+      std::fclose(file);
+    }
+  }
+
+  AsyncWriter(const AsyncWriter &) = delete;
+  AsyncWriter &operator=(const AsyncWriter &) = delete;
+
+  void write(const char *data, size_t size)
+  {
+    if (current.size() + size > capacity && !current.empty()) {
+      hand_off();
+    }
+    current.append(data, size);
+  }
+
+  void close()
+  {
+    hand_off();
+    stop();
+    bool ok = !failed && std::fclose(file) == 0;
+    file = nullptr;
+    if (!ok) {
+      throw std::runtime_error("Cannot write file: " + filename);
+    }
+  }
+
+private:
+  void hand_off()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this] { return pending.empty(); });
+    std::swap(current, pending);
+    cond.notify_all();
+  }
+
+  void work()
+  {
+    set_trace_thread_name("sort writer");
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      cond.wait(lock, [this] { return !pending.empty() || stopping; });
+      if (pending.empty()) {
+        return;
+      }
+      lock.unlock();
+      bool ok = false;
+      {
+        TRACE_SCOPE("write output block");
+        ok = std::fwrite(pending.data(), 1, pending.size(), file) == pending.size();
+      }
+      lock.lock();
+      failed = failed || !ok;
+      pending.clear();
+      cond.notify_all();
+    }
+  }
+
+  void stop()
+  {
+    if (!writer.joinable()) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    cond.notify_all();
+    writer.join();
+  }
+
+  std::string filename;
+  size_t capacity;
+  std::FILE *file = nullptr;
+  std::string current;
+  std::string pending;
+  std::thread writer;
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool stopping = false;
+  bool failed = false;
+};
+
+// Merges runs with a loser tree into writer, as CSV lines, or as run records
+// (intermediate passes); rows with equal keys keep the order of the runs
+void merge_runs(const std::vector<std::string> &paths, size_t buffer_size, AsyncWriter &writer, bool as_records)
+{
+  std::vector<std::unique_ptr<RunReader>> runs;
+  for (const std::string &path : paths) {
+    runs.push_back(std::make_unique<RunReader>(path, buffer_size));
+  }
+  LoserTree tree(runs);
+  for (int w = tree.winner(); w < static_cast<int>(runs.size()) && !runs[w]->done; w = tree.winner()) {
+    const RunReader &run = *runs[w];
+    if (as_records) {
+      uint32_t length = static_cast<uint32_t>(run.row.size());
+      writer.write(reinterpret_cast<const char *>(&run.key), sizeof(run.key));
+      writer.write(reinterpret_cast<const char *>(&length), sizeof(length));
+      writer.write(run.row.data(), run.row.size());
+    } else {
+      writer.write(run.row.data(), run.row.size());
+      writer.write("\n", 1);
+    }
+    runs[w]->next();
+    tree.replay(w);
+  }
+}
+
+// Sort key of a row: its timestamp (first field), in epoch milliseconds
+int64_t row_key(std::string_view row, const CsvDialect &dialect, const std::string &filename)
+{
+  std::string_view field = row.substr(0, row.find(dialect.delimiter));
+  if (dialect.quoted && field.size() >= 2 && field.front() == '"') {
+    field = field.substr(1, field.find('"', 1) - 1);
+  }
+  std::chrono::system_clock::time_point tp;
+  if (!parse_timestamp(field, dialect.timestamp_layout, tp)) {
+    throw std::runtime_error("Failed to parse datetime: " + std::string(field) + " in file: " + filename);
+  }
+  return std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count();
+}
+
+} // namespace
+
+/**
+ * Sorts the rows of CSV files by timestamp into one output file, with
+ * bounded memory, whatever the total size (external merge sort).
+ *
+ * Run generation: the inputs are read by blocks (read_text_file_by_blocks,
+ * so BOMs and CRLF are normalized) and rows are gathered into runs that
+ * fit in the memory budget, parsing only the timestamp (first field) as
+ * the sort key. Full runs are handed to worker threads, which sort them by
+ * a stable radix sort on the int64 epoch milliseconds and spill them to
+ * temporary binary files, while the next run is being read.
+ *
+ * Merge: the runs are merged k-way with a loser tree; the output is
+ * written by a background thread (double-buffering). Each run being
+ * merged needs a read buffer of at least 64 KiB, so when there are more
+ * runs than half the budget allows, groups of runs are first merged into
+ * longer runs, in as many passes as needed (with at least 2 runs per
+ * pass: budgets under 512 KiB are exceeded while merging).
+ *
+ * The sort is stable: rows with equal timestamps keep their input order
+ * (files in the given order). The header of the first file, if any, is
+ * written first; the headers of the other files are dropped, as well as
+ * blank lines. Temporary files are removed, also on error.
+ *
+ * @param inputs Paths to the CSV files, with the same dialect
+ * @param output Path to the sorted CSV file (LF line endings)
+ * @param dialect The dialect of the inputs (delimiter, quoting, header, timestamp layout)
+ * @param options Memory budget, number of threads, temporary directory
+ * @return ExternalSortResult Number of rows, of runs and of merge passes
+ * @throws std::runtime_error if a file cannot be read or written, or a timestamp is invalid
+ *
+ * Example:
+ *   sort_csv_files_by_time({"dump1.csv", "dump2.csv"}, "sorted.csv", sniff_csv_file("dump1.csv"))
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+ExternalSortResult sort_csv_files_by_time(const std::vector<std::string> &inputs, const std::string &output,
+                                          const CsvDialect &dialect, const ExternalSortOptions &options)
+{
+  const int nb_threads = options.nb_threads > 0 ? options.nb_threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  const size_t run_capacity = std::min<size_t>(options.memory_budget / (nb_threads + 1), UINT32_MAX);
+  if (run_capacity < 4096) {
+    throw std::invalid_argument("Memory budget too small");
+  }
+  const std::filesystem::path temp_directory =
+      options.temp_directory.empty() ? std::filesystem::temp_directory_path() : std::filesystem::path(options.temp_directory);
+  const std::string prefix =
+      (temp_directory / ("cpp_utils_sort_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "_")).string();
+
+  ExternalSortResult result;
+  RunSpiller spiller(nb_threads, run_capacity, prefix);
+
+  // 1. Runs
+  TRACE_SCOPE("sort_csv_files_by_time");
+  std::string header;
+  Run *run = spiller.acquire();
+  for (size_t f = 0; f < inputs.size(); f++) {
+    TRACE_SCOPE("read input file");
+    const std::string &filename = inputs[f];
+    bool header_pending = dialect.has_header;
+    std::string partial; // line straddling two blocks
+
+    auto add_line = [&](const char *begin, const char *end) {
+      if (std::all_of(begin, end, [](char c) { return c == ' ' || c == '\t' || c == '\r'; })) {
+        return;
+      }
+      if (header_pending) {
+        header_pending = false;
+        if (f == 0) {
+          header.assign(begin, end);
+        }
+        return;
+      }
+      int64_t key = row_key(std::string_view(begin, static_cast<size_t>(end - begin)), dialect, filename);
+      size_t length = static_cast<size_t>(end - begin);
+      if (!run->entries.empty() && !run->fits(length)) {
+        spiller.submit(run);
+        run = spiller.acquire();
+      }
+      if (!run->fits(length)) {
+        throw std::runtime_error("Row too long for the memory budget in file: " + filename);
+      }
+      run->entries.push_back({key, static_cast<uint32_t>(run->rows.size()), static_cast<uint32_t>(length)});
+      run->rows.append(begin, end);
+      result.nb_rows++;
+    };
+
+    read_text_file_by_blocks(filename, [&](const char *data, size_t size, uint64_t) {
+      const char *p = data;
+      const char *end = data + size;
+      while (p < end) {
+        const char *newline = static_cast<const char *>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (newline == nullptr) {
+          partial.append(p, end);
+          break;
+        }
+        if (partial.empty()) {
+          add_line(p, newline);
+        } else {
+          partial.append(p, newline);
+          add_line(partial.data(), partial.data() + partial.size());
+          partial.clear();
+        }
+        p = newline + 1;
+      }
+    });
+    if (!partial.empty()) {
+      add_line(partial.data(), partial.data() + partial.size());
+    }
+  }
+  if (!run->entries.empty()) {
+    spiller.submit(run);
+  } else {
+    spiller.release(run);
+  }
+  const std::vector<std::string> &paths = spiller.finish();
+  result.nb_runs = paths.size();
+  result.peak_run_bytes = spiller.peak_run_bytes();
+
+  // 2. Merge, in passes of at most max_fan_in runs, so that the read
+  // buffers (and the two of the writer) take at most half the budget
+  TRACE_SCOPE("merge runs");
+  const size_t min_buffer_size = 64 << 10;
+  const size_t max_fan_in = std::max<size_t>(options.memory_budget / (2 * min_buffer_size), 4) - 2;
+  auto buffer_size = [&](size_t nb_runs) { return std::max(min_buffer_size, options.memory_budget / (2 * (nb_runs + 2))); };
+
+  std::vector<std::string> pass_paths = paths;
+  while (pass_paths.size() > max_fan_in) {
+    TRACE_SCOPE("intermediate merge pass");
+    std::vector<std::string> merged_paths;
+    for (size_t i = 0; i < pass_paths.size(); i += max_fan_in) {
+      std::vector<std::string> group(pass_paths.begin() + static_cast<std::ptrdiff_t>(i),
+                                     pass_paths.begin() + static_cast<std::ptrdiff_t>(std::min(i + max_fan_in, pass_paths.size())));
+      if (group.size() == 1) {
+        merged_paths.push_back(group[0]);
+        continue;
+      }
+      merged_paths.push_back(spiller.new_path());
+      AsyncWriter writer(merged_paths.back(), buffer_size(group.size()));
+      merge_runs(group, buffer_size(group.size()), writer, true);
+      writer.close();
+      for (const std::string &path : group) {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+      }
+    }
+    pass_paths.swap(merged_paths);
+    result.nb_merge_passes++;
+  }
+
+  AsyncWriter writer(output, buffer_size(pass_paths.size()));
+  if (dialect.has_header && !header.empty()) {
+    writer.write(header.data(), header.size());
+    writer.write("\n", 1);
+  }
+  merge_runs(pass_paths, buffer_size(pass_paths.size()), writer, false);
+  result.nb_merge_passes++;
+  writer.close();
+  return result;
+}
+
+int SHOW_sort_csv_files_by_time(void)
+{
+  const std::filesystem::path directory = std::filesystem::temp_directory_path();
+  const auto tp0 = parse_date_time_UTC("01.02.2013 00:00:00.000");
+  const int nb_rows = 300'000;
+
+  // Three vendor dumps, each covering random minutes in random order
+  std::vector<int> minutes(nb_rows);
+  for (int i = 0; i < nb_rows; i++) {
+    minutes[i] = i;
+  }
+  std::shuffle(minutes.begin(), minutes.end(), std::mt19937(42));
+  std::vector<std::string> inputs;
+  for (int f = 0; f < 3; f++) {
+    inputs.push_back((directory / ("cpp_utils_dump_" + std::to_string(f) + ".csv")).string());
+    std::ofstream file(inputs.back(), std::ios::binary);
+    file << "Gmt time;Open;High;Low;Close;Volume\r\n";
+    for (int i = f; i < nb_rows; i += 3) {
+      file << format_date_time_UTC(tp0 + std::chrono::minutes(minutes[i])) << ";1,36115;1,36118;1,36108;1,36108;37,95\r\n";
+    }
+  }
+  const std::string output = (directory / "cpp_utils_sorted.csv").string();
+
+  ExternalSortOptions options;
+  options.memory_budget = 4 << 20;
+  auto start = std::chrono::steady_clock::now();
+  ExternalSortResult result = sort_csv_files_by_time(inputs, output, sniff_csv_file(inputs[0]), options);
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> duration = end - start;
+
+  std::vector<OhlcvBar> bars = read_ohlcv_csv(output);
+  bool sorted = std::is_sorted(bars.begin(), bars.end(), [](const OhlcvBar &a, const OhlcvBar &b) { return a.time < b.time; });
+
+  std::cout << "sort_csv_files_by_time: " << result.nb_rows << " rows from " << inputs.size() << " files, "
+            << result.nb_runs << " runs and " << result.nb_merge_passes << " merge passes with a " << (options.memory_budget >> 20)
+            << " MB budget (in " << duration.count() << " s)" << std::endl;
+  std::cout << "Output sorted: " << (sorted && bars.size() == static_cast<size_t>(nb_rows) ? "yes" : "NO") << std::endl;
+
+  for (const std::string &input : inputs) {
+    std::filesystem::remove(input);
+  }
+  std::filesystem::remove(output);
+  return 0;
+}
+
+// end
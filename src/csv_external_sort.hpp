@@ -0,0 +1,26 @@
+#ifndef CSV_EXTERNAL_SORT_HPP
+#define CSV_EXTERNAL_SORT_HPP
+
+#include "csv_reader.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct ExternalSortOptions {
+  size_t memory_budget = 256 << 20; // bytes held at once by the runs being built or sorted (rows and sort entries)
+  int nb_threads = 0;               // threads sorting and spilling runs (0 = std::thread::hardware_concurrency())
+  std::string temp_directory;       // where runs are spilled; empty = std::filesystem::temp_directory_path()
+};
+
+struct ExternalSortResult {
+  size_t nb_rows = 0;         // data rows written (header excluded)
+  size_t nb_runs = 0;         // sorted runs spilled to disk
+  size_t nb_merge_passes = 0; // 1 when all runs are merged at once
+  size_t peak_run_bytes = 0;  // largest buffers of a run, at most memory_budget / (nb_threads + 1)
+};
+
+ExternalSortResult sort_csv_files_by_time(const std::vector<std::string> &inputs, const std::string &output,
+                                          const CsvDialect &dialect, const ExternalSortOptions &options = ExternalSortOptions());
+int SHOW_sort_csv_files_by_time(void);
+
+#endif // CSV_EXTERNAL_SORT_HPP
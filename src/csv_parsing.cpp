@@ -0,0 +1,329 @@
+#include "csv_parsing.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(__PCLMUL__)
+#include <immintrin.h>
+#endif
+
+// Compile with: -march=native (AVX2 and PCLMUL are used when available)
+
+namespace {
+
+// Bit i is set if p[i] == c, for the 64 bytes starting at p
+uint64_t byte_mask(const char *p, char c)
+{
+#if defined(__AVX2__)
+  const __m256i needle = _mm256_set1_epi8(c);
+  __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 32));
+  uint64_t mask_lo = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle)));
+  uint64_t mask_hi = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle)));
+  return mask_lo | (mask_hi << 32);
+#elif defined(__SSE2__)
+  const __m128i needle = _mm_set1_epi8(c);
+  uint64_t mask = 0;
+  for (int i = 0; i < 4; i++) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16 * i));
+    mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)))) << (16 * i);
+  }
+  return mask;
+#else
+  uint64_t mask = 0;
+  for (int i = 0; i < 64; i++) {
+    mask |= static_cast<uint64_t>(p[i] == c) << i;
+  }
+  return mask;
+#endif
+}
+
+// Bit i of the result is the XOR of bits 0..i of the input: applied to a
+// quote mask, it gives the bytes that are inside quotes.
+uint64_t prefix_xor(uint64_t bitmask)
+{
+#if defined(__PCLMUL__) && defined(__x86_64__)
+  // carry-less multiplication by all ones
+  __m128i result = _mm_clmulepi64_si128(_mm_set_epi64x(0, static_cast<long long>(bitmask)), _mm_set1_epi8('\xFF'), 0);
+  return static_cast<uint64_t>(_mm_cvtsi128_si64(result));
+#else
+  bitmask ^= bitmask << 1;
+  bitmask ^= bitmask << 2;
+  bitmask ^= bitmask << 4;
+  bitmask ^= bitmask << 8;
+  bitmask ^= bitmask << 16;
+  bitmask ^= bitmask << 32;
+  return bitmask;
+#endif
+}
+
+// Calls fn(block, pos) on the 64-byte blocks of [from, to), zero-padding the last one
+template <typename Fn>
+bool for_each_block(const char *data, size_t from, size_t to, const Fn &fn)
+{
+  char padded[64];
+  for (size_t pos = from; pos < to; pos += 64) {
+    const char *block = data + pos;
+    if (to - pos < 64) {
+      std::memset(padded, 0, sizeof(padded));
+      std::memcpy(padded, block, to - pos);
+      block = padded;
+    }
+    if (!fn(block, pos)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Parity of the number of quotes in [from, to)
+bool quote_parity(const char *data, size_t from, size_t to)
+{
+  uint64_t parity = 0;
+  for_each_block(data, from, to, [&](const char *block, size_t) {
+    parity ^= static_cast<uint64_t>(__builtin_popcountll(byte_mask(block, '"')));
+    return true;
+  });
+  return (parity & 1) != 0;
+}
+
+// First position p >= from that starts a record (p == size, or data[p - 1]
+// is a '\n' outside quotes), given the quote state at `from`
+size_t next_record_start(const char *data, size_t size, size_t from, bool in_quotes)
+{
+  uint64_t state = in_quotes ? ~0ULL : 0;
+  size_t found = size;
+  for_each_block(data, from, size, [&](const char *block, size_t pos) {
+    uint64_t inside = prefix_xor(byte_mask(block, '"')) ^ state;
+    uint64_t boundaries = byte_mask(block, '\n') & ~inside;
+    if (boundaries != 0) {
+      found = std::min(size, pos + static_cast<size_t>(__builtin_ctzll(boundaries)) + 1);
+      return false;
+    }
+    state = static_cast<uint64_t>(static_cast<int64_t>(inside) >> 63); // state after the block
+    return true;
+  });
+  return found;
+}
+
+// Sequential parser, starting at a record boundary (outside quotes).
+// Every quote toggles the quote state, except "" inside quotes which is a literal quote.
+void parse_records(const char *begin, const char *end, char delimiter, CsvTable &table)
+{
+  CsvRow row;
+  std::string field;
+  bool in_quotes = false;
+  bool touched = false; // the current record has content
+
+  for (const char *p = begin; p < end; p++) {
+    char c = *p;
+    if (in_quotes) {
+      if (c == '"') {
+        if (p + 1 < end && p[1] == '"') {
+          field += '"';
+          p++;
+        } else {
+          in_quotes = false;
+        }
+      } else {
+        field += c;
+      }
+    } else if (c == '"') {
+      in_quotes = true;
+      touched = true;
+    } else if (c == delimiter) {
+      row.push_back(std::move(field));
+      field.clear();
+      touched = true;
+    } else if (c == '\n') {
+      if (touched) {
+        row.push_back(std::move(field));
+        table.push_back(std::move(row));
+      }
+      field.clear();
+      row.clear();
+      touched = false;
+    } else if (c == '\r' && p + 1 < end && p[1] == '\n') {
+      // CRLF: the '\r' belongs to the record separator
+    } else {
+      field += c;
+      touched = true;
+    }
+  }
+
+  if (touched) {
+    row.push_back(std::move(field));
+    table.push_back(std::move(row));
+  }
+}
+
+template <typename Fn>
+void parallel_for(size_t n, const Fn &fn)
+{
+  std::vector<std::thread> threads;
+  threads.reserve(n);
+  for (size_t i = 1; i < n; i++) {
+    threads.emplace_back(fn, i);
+  }
+  if (n > 0) {
+    fn(0);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+} // namespace
+
+/**
+ * Parses CSV text (RFC 4180 style) into rows of unescaped fields.
+ *
+ * Fields may be enclosed in double quotes, in which case they may contain
+ * delimiters, newlines, and doubled quotes ("" stands for "). Records are
+ * separated by '\n' or "\r\n" outside quotes. Blank records are skipped,
+ * as in count_lines.
+ *
+ * @param text The CSV text
+ * @param delimiter The field delimiter (e.g. ',' or ';')
+ * @return CsvTable The rows, each being a vector of fields
+ *
+ * Example:
+ *   parse_csv("a;\"b;c\"\n1;\"x\"\"y\"\n", ';') returns {{"a", "b;c"}, {"1", "x\"y"}}
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+CsvTable parse_csv(std::string_view text, char delimiter)
+{
+  CsvTable table;
+  parse_records(text.data(), text.data() + text.size(), delimiter, table);
+  return table;
+}
+
+/**
+ * Splits CSV text into nb_chunks ranges that start on real record
+ * boundaries, even when quoted fields contain newlines.
+ *
+ * Phase one of parse_csv_parallel. The text is cut into equal byte
+ * ranges; the parity of the number of quotes of each range is computed in
+ * parallel (SIMD compare + popcount), and an exclusive XOR-scan of these
+ * parities gives the quote state at the start of each range. Each range
+ * then looks, in parallel, for its first newline outside quotes, using a
+ * SIMD prefix-XOR (carry-less multiplication) of the quote mask.
+ *
+ * @param text The CSV text
+ * @param nb_chunks Number of ranges
+ * @return std::vector<size_t> nb_chunks + 1 non-decreasing offsets, from 0 to text.size()
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+std::vector<size_t> find_csv_record_boundaries(std::string_view text, size_t nb_chunks)
+{
+  const char *data = text.data();
+  const size_t size = text.size();
+  nb_chunks = std::max<size_t>(nb_chunks, 1);
+
+  std::vector<size_t> starts(nb_chunks + 1);
+  for (size_t k = 0; k <= nb_chunks; k++) {
+    starts[k] = size / nb_chunks * k + std::min(k, size % nb_chunks);
+  }
+
+  std::vector<char> parities(nb_chunks);
+  parallel_for(nb_chunks, [&](size_t k) {
+    parities[k] = quote_parity(data, starts[k], starts[k + 1]);
+  });
+
+  std::vector<char> in_quotes(nb_chunks, 0);
+  for (size_t k = 1; k < nb_chunks; k++) {
+    in_quotes[k] = in_quotes[k - 1] ^ parities[k - 1];
+  }
+
+  std::vector<size_t> boundaries(nb_chunks + 1);
+  boundaries[0] = 0;
+  boundaries[nb_chunks] = size;
+  parallel_for(nb_chunks, [&](size_t k) {
+    if (k == 0) {
+      return;
+    }
+    size_t start = starts[k];
+    if (start > 0 && data[start - 1] == '\n' && !in_quotes[k]) {
+      boundaries[k] = start;
+    } else {
+      boundaries[k] = next_record_start(data, size, start, in_quotes[k] != 0);
+    }
+  });
+  return boundaries;
+}
+
+/**
+ * Parses CSV text in parallel, with the same result as parse_csv.
+ *
+ * Phase one finds real record boundaries (see find_csv_record_boundaries);
+ * phase two parses the resulting chunks independently, one per thread,
+ * and the rows are concatenated in order.
+ *
+ * @param text The CSV text
+ * @param delimiter The field delimiter
+ * @param nb_threads Number of threads (0 = std::thread::hardware_concurrency())
+ * @return CsvTable The rows, identical to parse_csv(text, delimiter)
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+CsvTable parse_csv_parallel(std::string_view text, char delimiter, int nb_threads)
+{
+  size_t nb_chunks = nb_threads > 0 ? static_cast<size_t>(nb_threads) : std::max(1u, std::thread::hardware_concurrency());
+  nb_chunks = std::max<size_t>(1, std::min(nb_chunks, text.size() / 4096 + 1)); // no point in tiny chunks
+
+  std::vector<size_t> boundaries = find_csv_record_boundaries(text, nb_chunks);
+
+  std::vector<CsvTable> tables(nb_chunks);
+  parallel_for(nb_chunks, [&](size_t k) {
+    parse_records(text.data() + boundaries[k], text.data() + boundaries[k + 1], delimiter, tables[k]);
+  });
+
+  size_t nb_rows = 0;
+  for (const CsvTable &table : tables) {
+    nb_rows += table.size();
+  }
+  CsvTable result;
+  result.reserve(nb_rows);
+  for (CsvTable &table : tables) {
+    std::move(table.begin(), table.end(), std::back_inserter(result));
+  }
+  return result;
+}
+
+int SHOW_parse_csv_parallel(void)
+{
+  std::string text = "Gmt time;Comment;Close\n";
+  for (int i = 0; i < 200'000; i++) {
+    text += "01.02.2013 00:00:00.000;";
+    text += (i % 3 == 0) ? "\"multi-line\ncomment; with \"\"quotes\"\"\"" : "plain";
+    text += ";1,3612" + std::to_string(i % 10) + "\r\n";
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  CsvTable sequential = parse_csv(text, ';');
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> sequential_duration = end - start;
+
+  start = std::chrono::steady_clock::now();
+  CsvTable parallel = parse_csv_parallel(text, ';');
+  end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> parallel_duration = end - start;
+
+  std::cout << "parse_csv:          " << sequential.size() << " rows (in " << sequential_duration.count() << " s)" << std::endl;
+  std::cout << "parse_csv_parallel: " << parallel.size() << " rows (in " << parallel_duration.count() << " s, "
+            << std::thread::hardware_concurrency() << " threads)" << std::endl;
+  std::cout << "Identical results: " << (sequential == parallel ? "yes" : "NO") << std::endl;
+  return 0;
+}
+
+// end
@@ -0,0 +1,17 @@
+#ifndef CSV_PARSING_HPP
+#define CSV_PARSING_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using CsvRow = std::vector<std::string>;
+using CsvTable = std::vector<CsvRow>;
+
+CsvTable parse_csv(std::string_view text, char delimiter);
+std::vector<size_t> find_csv_record_boundaries(std::string_view text, size_t nb_chunks);
+CsvTable parse_csv_parallel(std::string_view text, char delimiter, int nb_threads = 0);
+int SHOW_parse_csv_parallel(void);
+
+#endif // CSV_PARSING_HPP
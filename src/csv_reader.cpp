@@ -0,0 +1,974 @@
+#include "csv_reader.hpp"
+#include "csv_writer.hpp"
+#include "dates_and_times.hpp"
+#include "doubles.hpp"
+#include "files.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+using TimePoint = std::chrono::system_clock::time_point;
+
+// Days since 1970-01-01 of a civil date (H. Hinnant's algorithm, proleptic Gregorian calendar)
+long long days_from_civil(long long year, int month, int day)
+{
+  year -= (month <= 2);
+  const long long era = (year >= 0 ? year : year - 399) / 400;
+  const long long yoe = year - era * 400;
+  const long long doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  const long long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+inline bool read_digits(const char *p, int n, int &value)
+{
+  value = 0;
+  for (int i = 0; i < n; i++) {
+    unsigned digit = static_cast<unsigned>(static_cast<unsigned char>(p[i])) - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + static_cast<int>(digit);
+  }
+  return true;
+}
+
+inline bool make_time_point(int year, int month, int day, int hour, int minute, int second, int millis, TimePoint &tp)
+{
+  if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) {
+    return false;
+  }
+  long long ms = ((days_from_civil(year, month, day) * 24 + hour) * 60 + minute) * 60'000LL + second * 1000LL + millis;
+  tp = TimePoint(std::chrono::milliseconds(ms));
+  return true;
+}
+
+// Optional ".mmm" at p, then nothing else
+inline bool read_millis(const char *p, const char *end, int &millis)
+{
+  millis = 0;
+  if (p == end) {
+    return true;
+  }
+  return end - p == 4 && *p == '.' && read_digits(p + 1, 3, millis);
+}
+
+// Fixed-width parsers, specialized per layout
+template <TimestampLayout Layout>
+bool parse_timestamp_fixed(const char *p, const char *end, TimePoint &tp)
+{
+  int year, month, day, hour, minute, second, millis;
+  if constexpr (Layout == TimestampLayout::DMY) {
+    return end - p >= 19 && p[2] == '.' && p[5] == '.' && p[10] == ' ' && p[13] == ':' && p[16] == ':' &&
+           read_digits(p, 2, day) && read_digits(p + 3, 2, month) && read_digits(p + 6, 4, year) &&
+           read_digits(p + 11, 2, hour) && read_digits(p + 14, 2, minute) && read_digits(p + 17, 2, second) &&
+           read_millis(p + 19, end, millis) && make_time_point(year, month, day, hour, minute, second, millis, tp);
+  } else if constexpr (Layout == TimestampLayout::ISO) {
+    if (end > p && end[-1] == 'Z') {
+      end--;
+    }
+    return end - p >= 19 && p[4] == '-' && p[7] == '-' && (p[10] == ' ' || p[10] == 'T') && p[13] == ':' && p[16] == ':' &&
+           read_digits(p, 4, year) && read_digits(p + 5, 2, month) && read_digits(p + 8, 2, day) &&
+           read_digits(p + 11, 2, hour) && read_digits(p + 14, 2, minute) && read_digits(p + 17, 2, second) &&
+           read_millis(p + 19, end, millis) && make_time_point(year, month, day, hour, minute, second, millis, tp);
+  } else {
+    long long value = 0;
+    auto result = std::from_chars(p, end, value);
+    if (p == end || result.ec != std::errc() || result.ptr != end) {
+      return false;
+    }
+    tp = TimePoint(Layout == TimestampLayout::EPOCH_SECONDS ? std::chrono::milliseconds(value * 1000) : std::chrono::milliseconds(value));
+    return true;
+  }
+}
+
+template <TimestampLayout Layout>
+TimePoint parse_timestamp_as(const char *first, const char *last)
+{
+  TimePoint tp;
+  if (parse_timestamp_fixed<Layout>(first, last, tp)) {
+    return tp;
+  }
+  if constexpr (Layout == TimestampLayout::DMY) {
+    return parse_date_time_UTC(std::string(first, last)); // single-digit fields, etc.
+  }
+  throw std::runtime_error("Failed to parse datetime: " + std::string(first, last));
+}
+
+template <char Decimal>
+double parse_number(const char *first, const char *last)
+{
+  while (first < last && *first == ' ') {
+    first++;
+  }
+  while (last > first && last[-1] == ' ') {
+    last--;
+  }
+  const char *begin = (first < last && *first == '+') ? first + 1 : first;
+
+  double value = 0.0;
+  std::from_chars_result result;
+  const char *end;
+  if constexpr (Decimal == '.') {
+    result = std::from_chars(begin, last, value);
+    end = last;
+  } else {
+    char buffer[64];
+    size_t n = static_cast<size_t>(last - begin);
+    if (n > sizeof(buffer)) {
+      throw std::invalid_argument("Invalid number: " + std::string(first, last));
+    }
+    for (size_t i = 0; i < n; i++) {
+      buffer[i] = (begin[i] == Decimal) ? '.' : begin[i];
+    }
+    result = std::from_chars(buffer, buffer + n, value);
+    end = buffer + n;
+  }
+
+  if (result.ec == std::errc::result_out_of_range) {
+    throw std::out_of_range("Number out of range: " + std::string(first, last));
+  }
+  if (result.ec != std::errc() || result.ptr != end) {
+    throw std::invalid_argument("Invalid number: " + std::string(first, last));
+  }
+  return value;
+}
+
+// Reads the field starting at p; returns the start of the next field, or nullptr after the last one
+template <char Delimiter, bool Quoted>
+inline const char *next_field(const char *p, const char *end, const char *&field_begin, const char *&field_end)
+{
+  if constexpr (Quoted) {
+    if (p < end && *p == '"') {
+      const char *close = static_cast<const char *>(std::memchr(p + 1, '"', end - p - 1));
+      if (close == nullptr) {
+        throw std::runtime_error("Unterminated quoted field: " + std::string(p, end));
+      }
+      field_begin = p + 1;
+      field_end = close;
+      p = close + 1;
+      const char *delimiter = static_cast<const char *>(std::memchr(p, Delimiter, end - p));
+      return (delimiter == nullptr) ? nullptr : delimiter + 1;
+    }
+  }
+  const char *delimiter = static_cast<const char *>(std::memchr(p, Delimiter, end - p));
+  field_begin = p;
+  field_end = (delimiter == nullptr) ? end : delimiter;
+  return (delimiter == nullptr) ? nullptr : delimiter + 1;
+}
+
+// Row loop specialized for one dialect: no configuration is checked per row.
+// If Ranged, rows outside the range are skipped after parsing only their
+// timestamp; returns false if the scan stopped early (sorted range passed).
+template <char Delimiter, char Decimal, TimestampLayout Layout, bool Quoted, bool Ranged>
+bool read_rows(const char *begin, const char *end, std::vector<OhlcvBar> &bars, const TimeRange *range)
+{
+  const char *p = begin;
+  while (p < end) {
+    const char *newline = static_cast<const char *>(std::memchr(p, '\n', end - p));
+    const char *line_end = (newline == nullptr) ? end : newline;
+    const char *next = (newline == nullptr) ? end : newline + 1;
+    if (line_end > p && line_end[-1] == '\r') {
+      line_end--;
+    }
+
+    if (line_end > p) {
+      OhlcvBar bar;
+      const char *field_begin;
+      const char *field_end;
+      const char *q = next_field<Delimiter, Quoted>(p, line_end, field_begin, field_end);
+      bar.time = parse_timestamp_as<Layout>(field_begin, field_end);
+      if constexpr (Ranged) {
+        if (bar.time < range->from) {
+          p = next;
+          continue;
+        }
+        if (bar.time >= range->to) {
+          if (range->sorted) {
+            return false;
+          }
+          p = next;
+          continue;
+        }
+      }
+      double *values[] = {&bar.open, &bar.high, &bar.low, &bar.close};
+      for (double *value : values) {
+        if (q == nullptr) {
+          throw std::runtime_error("Missing fields in row: " + std::string(p, line_end));
+        }
+        q = next_field<Delimiter, Quoted>(q, line_end, field_begin, field_end);
+        *value = parse_number<Decimal>(field_begin, field_end);
+      }
+      if (q != nullptr) { // volume is optional
+        next_field<Delimiter, Quoted>(q, line_end, field_begin, field_end);
+        bar.volume = parse_number<Decimal>(field_begin, field_end);
+      }
+      bars.push_back(bar);
+    }
+    p = next;
+  }
+  return true;
+}
+
+// Column-oriented row loop: only the projected columns are converted, the
+// other fields are jumped over, and the rest of the row after the last
+// projected column is not scanned.
+template <char Delimiter, char Decimal, TimestampLayout Layout, bool Quoted, typename Columns>
+void read_columns(const char *begin, const char *end, unsigned columns, Columns &out)
+{
+  decltype(out.open) *targets[] = {&out.open, &out.high, &out.low, &out.close, &out.volume};
+  int last = 0; // index of the last projected column (0 = time)
+  for (int c = 0; c <= 5; c++) {
+    if (columns & (1u << c)) {
+      last = c;
+    }
+  }
+
+  const char *p = begin;
+  while (p < end) {
+    const char *newline = static_cast<const char *>(std::memchr(p, '\n', end - p));
+    const char *line_end = (newline == nullptr) ? end : newline;
+    const char *next = (newline == nullptr) ? end : newline + 1;
+    if (line_end > p && line_end[-1] == '\r') {
+      line_end--;
+    }
+
+    if (line_end > p) {
+      const char *field_begin;
+      const char *field_end;
+      const char *q = next_field<Delimiter, Quoted>(p, line_end, field_begin, field_end);
+      if (columns & OHLCV_TIME) {
+        out.time.push_back(parse_timestamp_as<Layout>(field_begin, field_end));
+      }
+      for (int c = 1; c <= last; c++) {
+        if (q == nullptr) {
+          if (c < 5) {
+            throw std::runtime_error("Missing fields in row: " + std::string(p, line_end));
+          }
+          targets[c - 1]->push_back(0.0); // volume is optional
+          break;
+        }
+        q = next_field<Delimiter, Quoted>(q, line_end, field_begin, field_end);
+        if (columns & (1u << c)) {
+          targets[c - 1]->push_back(parse_number<Decimal>(field_begin, field_end));
+        }
+      }
+    }
+    p = next;
+  }
+}
+
+// Calls selector.template apply<Delimiter, Decimal, Layout, Quoted>() for the dialect,
+// so that the selected kernel is instantiated for this exact dialect
+template <char Delimiter, char Decimal, TimestampLayout Layout, typename Selector>
+auto visit_quoting(const CsvDialect &dialect, const Selector &selector)
+{
+  return dialect.quoted ? selector.template apply<Delimiter, Decimal, Layout, true>()
+                        : selector.template apply<Delimiter, Decimal, Layout, false>();
+}
+
+template <char Delimiter, char Decimal, typename Selector>
+auto visit_layout(const CsvDialect &dialect, const Selector &selector)
+{
+  switch (dialect.timestamp_layout) {
+  case TimestampLayout::DMY:
+    return visit_quoting<Delimiter, Decimal, TimestampLayout::DMY>(dialect, selector);
+  case TimestampLayout::ISO:
+    return visit_quoting<Delimiter, Decimal, TimestampLayout::ISO>(dialect, selector);
+  case TimestampLayout::EPOCH_SECONDS:
+    return visit_quoting<Delimiter, Decimal, TimestampLayout::EPOCH_SECONDS>(dialect, selector);
+  case TimestampLayout::EPOCH_MILLISECONDS:
+    return visit_quoting<Delimiter, Decimal, TimestampLayout::EPOCH_MILLISECONDS>(dialect, selector);
+  default:
+    throw std::invalid_argument("Unknown timestamp layout");
+  }
+}
+
+template <char Delimiter, typename Selector>
+auto visit_decimal(const CsvDialect &dialect, const Selector &selector)
+{
+  return dialect.decimal_separator == ',' ? visit_layout<Delimiter, ','>(dialect, selector)
+                                          : visit_layout<Delimiter, '.'>(dialect, selector);
+}
+
+template <typename Selector>
+auto visit_dialect(const CsvDialect &dialect, const Selector &selector)
+{
+  switch (dialect.delimiter) {
+  case ';':
+    return visit_decimal<';'>(dialect, selector);
+  case ',':
+    return visit_decimal<','>(dialect, selector);
+  case '\t':
+    return visit_decimal<'\t'>(dialect, selector);
+  case '|':
+    return visit_decimal<'|'>(dialect, selector);
+  default:
+    throw std::invalid_argument(std::string("Unsupported CSV delimiter: ") + dialect.delimiter);
+  }
+}
+
+using RowReader = bool (*)(const char *, const char *, std::vector<OhlcvBar> &, const TimeRange *);
+template <typename Columns>
+using ColumnReader = void (*)(const char *, const char *, unsigned, Columns &);
+
+struct RowReaderSelector {
+  bool ranged;
+  template <char Delimiter, char Decimal, TimestampLayout Layout, bool Quoted>
+  RowReader apply() const
+  {
+    return ranged ? &read_rows<Delimiter, Decimal, Layout, Quoted, true> : &read_rows<Delimiter, Decimal, Layout, Quoted, false>;
+  }
+};
+
+template <typename Columns>
+struct ColumnReaderSelector {
+  template <char Delimiter, char Decimal, TimestampLayout Layout, bool Quoted>
+  ColumnReader<Columns> apply() const
+  {
+    return &read_columns<Delimiter, Decimal, Layout, Quoted, Columns>;
+  }
+};
+
+std::string_view trim(std::string_view text)
+{
+  while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+// Splits a line on a delimiter, outside quotes, removing the quotes
+std::vector<std::string_view> split_fields(std::string_view line, char delimiter)
+{
+  std::vector<std::string_view> fields;
+  size_t start = 0;
+  bool in_quotes = false;
+  for (size_t i = 0; i <= line.size(); i++) {
+    if (i < line.size() && line[i] == '"') {
+      in_quotes = !in_quotes;
+    } else if (i == line.size() || (line[i] == delimiter && !in_quotes)) {
+      std::string_view field = trim(line.substr(start, i - start));
+      if (field.size() >= 2 && field.front() == '"' && field.back() == '"') {
+        field = field.substr(1, field.size() - 2);
+      }
+      fields.push_back(field);
+      start = i + 1;
+    }
+  }
+  return fields;
+}
+
+size_t count_outside_quotes(std::string_view line, char c)
+{
+  size_t count = 0;
+  bool in_quotes = false;
+  for (char x : line) {
+    if (x == '"') {
+      in_quotes = !in_quotes;
+    } else if (x == c && !in_quotes) {
+      count++;
+    }
+  }
+  return count;
+}
+
+TimestampLayout detect_layout(std::string_view field)
+{
+  const TimestampLayout layouts[] = {TimestampLayout::DMY, TimestampLayout::ISO};
+  TimePoint tp;
+  for (TimestampLayout layout : layouts) {
+    if (parse_timestamp(field, layout, tp)) {
+      return layout;
+    }
+  }
+  bool all_digits = !field.empty() && field.find_first_not_of("0123456789") == std::string_view::npos;
+  if (all_digits && field.size() >= 12) {
+    return TimestampLayout::EPOCH_MILLISECONDS;
+  }
+  if (all_digits) {
+    return TimestampLayout::EPOCH_SECONDS;
+  }
+  return TimestampLayout::UNKNOWN;
+}
+
+// Skips blank lines and the header line; returns the start of the next line, or nullptr if no header in [begin, end)
+const char *skip_header(const char *begin, const char *end)
+{
+  while (begin < end) {
+    const char *newline = static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+    const char *line_end = (newline == nullptr) ? end : newline;
+    bool blank = trim(std::string_view(begin, line_end - begin)).empty();
+    begin = (newline == nullptr) ? end : newline + 1;
+    if (!blank) {
+      return begin;
+    }
+  }
+  return nullptr;
+}
+
+// Calls on_rows(begin, end) on successive ranges of complete rows of a file,
+// read in blocks of 1 MB, after the header if has_header; stops early if
+// on_rows returns false
+template <typename Fn>
+void for_each_row_block(const std::string &filename, bool has_header, const Fn &on_rows)
+{
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+
+  std::string buffer(1 << 20, '\0');
+  size_t used = 0;
+  bool header_pending = has_header;
+  while (true) {
+    if (used == buffer.size()) {
+      buffer.resize(buffer.size() * 2); // a line longer than the buffer
+    }
+    file.read(buffer.data() + used, static_cast<std::streamsize>(buffer.size() - used));
+    size_t nb_read = static_cast<size_t>(file.gcount());
+    bool at_eof = used + nb_read < buffer.size();
+    used += nb_read;
+
+    // Complete lines only, except at end of file
+    const char *begin = buffer.data();
+    const char *end = begin + used;
+    const char *complete_end = end;
+    if (!at_eof) {
+      size_t last_newline = std::string_view(begin, used).rfind('\n');
+      complete_end = (last_newline == std::string_view::npos) ? begin : begin + last_newline + 1;
+    }
+
+    if (header_pending) {
+      const char *after_header = skip_header(begin, complete_end);
+      header_pending = (after_header == nullptr);
+      begin = header_pending ? complete_end : after_header;
+    }
+    if (!on_rows(begin, complete_end) || at_eof) {
+      break;
+    }
+
+    used = static_cast<size_t>(end - complete_end);
+    std::memmove(buffer.data(), complete_end, used);
+  }
+}
+
+std::string read_whole_file(const std::string &filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+  std::string content;
+  std::error_code ec;
+  content.resize(static_cast<size_t>(std::filesystem::file_size(filename, ec)));
+  file.read(content.data(), static_cast<std::streamsize>(content.size()));
+  content.resize(static_cast<size_t>(file.gcount()));
+  return content;
+}
+
+} // namespace
+
+/**
+ * Parses a timestamp with a given layout, without throwing.
+ *
+ * Fixed-width layouts are decoded digit by digit (no sscanf). For the DMY
+ * layout, inputs that are not fixed-width (e.g. single-digit day) are
+ * delegated to parse_date_time_UTC. With TimestampLayout::UNKNOWN, every
+ * layout is tried. Surrounding whitespace is ignored.
+ *
+ * @param text The timestamp
+ * @param layout The expected layout
+ * @param tp Receives the UTC time point on success
+ * @return bool true if the timestamp was parsed
+ *
+ * Example:
+ *   parse_timestamp("2013-02-01T00:00:00.123Z", TimestampLayout::ISO, tp) returns true
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+bool parse_timestamp(std::string_view text, TimestampLayout layout, std::chrono::system_clock::time_point &tp)
+{
+  text = trim(text);
+  const char *first = text.data();
+  const char *last = first + text.size();
+  switch (layout) {
+  case TimestampLayout::DMY:
+    if (parse_timestamp_fixed<TimestampLayout::DMY>(first, last, tp)) {
+      return true;
+    }
+    try {
+      tp = parse_date_time_UTC(std::string(text));
+      return true;
+    } catch (const std::runtime_error &) {
+      return false;
+    }
+  case TimestampLayout::ISO:
+    return parse_timestamp_fixed<TimestampLayout::ISO>(first, last, tp);
+  case TimestampLayout::EPOCH_SECONDS:
+    return parse_timestamp_fixed<TimestampLayout::EPOCH_SECONDS>(first, last, tp);
+  case TimestampLayout::EPOCH_MILLISECONDS:
+    return parse_timestamp_fixed<TimestampLayout::EPOCH_MILLISECONDS>(first, last, tp);
+  default:
+    return parse_timestamp(text, TimestampLayout::DMY, tp) || parse_timestamp(text, TimestampLayout::ISO, tp) ||
+           parse_timestamp(text, TimestampLayout::EPOCH_MILLISECONDS, tp);
+  }
+}
+
+/**
+ * Infers the dialect of a CSV sample (typically the first few KB of a file).
+ *
+ *   - delimiter: the candidate (';', '\t', '|', ',') occurring the same
+ *     non-zero number of times, outside quotes, on every line; ties go to
+ *     the first one of this list, since ',' may also be a decimal separator
+ *   - quoting: whether double quotes appear
+ *   - timestamp layout: from the first field of the last complete line
+ *   - header: whether the first field of the first line is not a timestamp
+ *   - decimal separator: ',' if a numeric field contains one, '.' otherwise
+ *
+ * @param sample The beginning of the CSV text
+ * @return CsvDialect The inferred dialect (default dialect for an empty sample)
+ *
+ * Example:
+ *   sniff_csv_dialect("Gmt time;Open\n01.02.2013 00:00:00.000;1,36115\n")
+ *   returns {';', ',', false, true, TimestampLayout::DMY}
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+CsvDialect sniff_csv_dialect(std::string_view sample)
+{
+  CsvDialect dialect;
+
+  // Complete, non-blank lines only
+  size_t last_newline = sample.rfind('\n');
+  if (last_newline != std::string_view::npos) {
+    sample = sample.substr(0, last_newline + 1);
+  }
+  std::vector<std::string_view> lines;
+  size_t start = 0;
+  while (start < sample.size() && lines.size() < 64) {
+    size_t newline = sample.find('\n', start);
+    size_t end = (newline == std::string_view::npos) ? sample.size() : newline;
+    std::string_view line = sample.substr(start, end - start);
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    if (!trim(line).empty()) {
+      lines.push_back(line);
+    }
+    start = end + 1;
+  }
+  if (lines.empty()) {
+    return dialect;
+  }
+
+  // Delimiter: consistent on all lines, or else on all lines but the header
+  const char candidates[] = {';', '\t', '|', ','};
+  bool found = false;
+  for (size_t first_line = 0; first_line < 2 && !found; first_line++) {
+    for (char candidate : candidates) {
+      if (first_line >= lines.size()) {
+        break;
+      }
+      size_t count = count_outside_quotes(lines[first_line], candidate);
+      bool consistent = count > 0;
+      for (size_t i = first_line + 1; i < lines.size() && consistent; i++) {
+        consistent = count_outside_quotes(lines[i], candidate) == count;
+      }
+      if (consistent) {
+        dialect.delimiter = candidate;
+        found = true;
+        break;
+      }
+    }
+  }
+  if (!found) {
+    size_t best = 0;
+    for (char candidate : candidates) {
+      size_t count = count_outside_quotes(sample, candidate);
+      if (count > best) {
+        best = count;
+        dialect.delimiter = candidate;
+      }
+    }
+  }
+
+  dialect.quoted = sample.find('"') != std::string_view::npos;
+
+  std::vector<std::string_view> last_fields = split_fields(lines.back(), dialect.delimiter);
+  dialect.timestamp_layout = detect_layout(last_fields[0]);
+
+  TimePoint tp;
+  std::vector<std::string_view> first_fields = split_fields(lines.front(), dialect.delimiter);
+  if (dialect.timestamp_layout != TimestampLayout::UNKNOWN) {
+    dialect.has_header = !parse_timestamp(first_fields[0], dialect.timestamp_layout, tp);
+  } else {
+    dialect.has_header = lines.size() > 1 && std::any_of(lines[0].begin(), lines[0].end(), [](char c) { return std::isalpha(static_cast<unsigned char>(c)); });
+  }
+
+  dialect.decimal_separator = '.';
+  if (dialect.delimiter != ',') {
+    for (size_t i = dialect.has_header ? 1 : 0; i < lines.size(); i++) {
+      std::vector<std::string_view> fields = split_fields(lines[i], dialect.delimiter);
+      for (size_t f = 1; f < fields.size(); f++) {
+        if (fields[f].find(',') != std::string_view::npos) {
+          dialect.decimal_separator = ',';
+        }
+      }
+    }
+  }
+
+  return dialect;
+}
+
+/**
+ * Infers the dialect of a CSV file from its first sample_size bytes.
+ *
+ * @throws std::runtime_error if the file cannot be opened
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+CsvDialect sniff_csv_file(const std::string &filename, size_t sample_size)
+{
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+  std::string sample(sample_size, '\0');
+  file.read(sample.data(), static_cast<std::streamsize>(sample.size()));
+  sample.resize(static_cast<size_t>(file.gcount()));
+  return sniff_csv_dialect(sample);
+}
+
+/**
+ * Reads an OHLCV CSV file (timestamp, open, high, low, close and optional
+ * volume), with the given dialect.
+ *
+ * The dialect is resolved once per file into a row loop instantiated for
+ * that exact combination of delimiter, decimal separator, timestamp
+ * layout and quoting, so that the per-row loop is free of configuration
+ * checks. Fields are found with memchr and numbers are converted with
+ * std::from_chars.
+ *
+ * @param filename Path to the CSV file
+ * @param dialect The dialect of the file (see sniff_csv_file)
+ * @return std::vector<OhlcvBar> The bars, in file order
+ * @throws std::runtime_error if the file cannot be opened, or a row has missing fields or an invalid timestamp
+ * @throws std::invalid_argument if a number is invalid or the dialect is not supported
+ * @throws std::out_of_range if a number is out of the range of double
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+std::vector<OhlcvBar> read_ohlcv_csv(const std::string &filename, const CsvDialect &dialect)
+{
+  TRACE_SCOPE("read_ohlcv_csv");
+  RowReader read = visit_dialect(dialect, RowReaderSelector{false});
+
+  std::string content = read_whole_file(filename);
+  const char *begin = content.data();
+  const char *end = begin + content.size();
+
+  if (dialect.has_header) {
+    const char *after_header = skip_header(begin, end);
+    begin = (after_header == nullptr) ? end : after_header;
+  }
+
+  std::vector<OhlcvBar> bars;
+  const char *first_newline = static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+  if (first_newline != nullptr) {
+    bars.reserve(static_cast<size_t>(end - begin) / static_cast<size_t>(first_newline - begin + 1) + 1); // estimate, no counting pass
+  }
+  read(begin, end, bars, nullptr);
+  return bars;
+}
+
+/**
+ * Reads the bars of an OHLCV CSV file whose timestamp is in [range.from, range.to).
+ *
+ * The predicate is pushed down into the row loop: for rows outside the
+ * range, only the timestamp is parsed (fixed-width fast path) and the
+ * other fields are skipped. If range.sorted, the scan, and the reading of
+ * the file, stop at the first row at or after range.to. The file is read
+ * in 1 MB blocks, so that an early stop avoids reading the rest.
+ *
+ * @param filename Path to the CSV file
+ * @param dialect The dialect of the file (see sniff_csv_file)
+ * @param range The time range, and whether rows are in increasing time order
+ * @return std::vector<OhlcvBar> The bars in the range, in file order
+ * @throws same as read_ohlcv_csv(filename, dialect), for the rows that are parsed
+ *
+ * Example:
+ *   read_ohlcv_csv("EURUSD.csv", dialect, {parse_date_time_UTC("01.02.2013 00:00:00"), parse_date_time_UTC("02.02.2013 00:00:00")})
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+std::vector<OhlcvBar> read_ohlcv_csv(const std::string &filename, const CsvDialect &dialect, const TimeRange &range)
+{
+  TRACE_SCOPE("read_ohlcv_csv (time range)");
+  RowReader read = visit_dialect(dialect, RowReaderSelector{true});
+
+  std::vector<OhlcvBar> bars;
+  for_each_row_block(filename, dialect.has_header, [&](const char *begin, const char *end) {
+    return read(begin, end, bars, &range);
+  });
+  return bars;
+}
+
+/**
+ * Reads an OHLCV CSV file, inferring its dialect from its first 16 KB.
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+std::vector<OhlcvBar> read_ohlcv_csv(const std::string &filename)
+{
+  return read_ohlcv_csv(filename, sniff_csv_file(filename));
+}
+
+/**
+ * Reads the bars of an OHLCV CSV file in a time range, inferring its dialect from its first 16 KB.
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+std::vector<OhlcvBar> read_ohlcv_csv(const std::string &filename, const TimeRange &range)
+{
+  return read_ohlcv_csv(filename, sniff_csv_file(filename), range);
+}
+
+/**
+ * Reads only some columns of an OHLCV CSV file, into one vector per column.
+ *
+ * Fields of the columns that are not projected are jumped over with a
+ * delimiter scan, without conversion, and the end of each row after the
+ * last projected column is not even scanned; the vectors of the columns
+ * that are not projected stay empty. Parse time and memory thus shrink
+ * roughly in proportion to the columns dropped.
+ *
+ * @param filename Path to the CSV file
+ * @param dialect The dialect of the file (see sniff_csv_file)
+ * @param columns The projected columns, e.g. OHLCV_TIME | OHLCV_CLOSE
+ * @return OhlcvColumns The projected columns, in file order
+ * @throws same as read_ohlcv_csv(filename, dialect), for the fields that are read
+ *
+ * Example:
+ *   OhlcvColumns c = read_ohlcv_columns("EURUSD.csv", dialect, OHLCV_TIME | OHLCV_CLOSE);
+ *   c.close[i] is the close at c.time[i]; c.open is empty
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+OhlcvColumns read_ohlcv_columns(const std::string &filename, const CsvDialect &dialect, unsigned columns)
+{
+  TRACE_SCOPE("read_ohlcv_columns");
+  ColumnReader<OhlcvColumns> read = visit_dialect(dialect, ColumnReaderSelector<OhlcvColumns>());
+
+  std::string content = read_whole_file(filename);
+  const char *begin = content.data();
+  const char *end = begin + content.size();
+
+  if (dialect.has_header) {
+    const char *after_header = skip_header(begin, end);
+    begin = (after_header == nullptr) ? end : after_header;
+  }
+
+  OhlcvColumns out;
+  const char *first_newline = static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+  if (first_newline != nullptr) {
+    size_t estimate = static_cast<size_t>(end - begin) / static_cast<size_t>(first_newline - begin + 1) + 1;
+    if (columns & OHLCV_TIME) {
+      out.time.reserve(estimate);
+    }
+    std::vector<double> *targets[] = {&out.open, &out.high, &out.low, &out.close, &out.volume};
+    for (int c = 1; c <= 5; c++) {
+      if (columns & (1u << c)) {
+        targets[c - 1]->reserve(estimate);
+      }
+    }
+  }
+  read(begin, end, columns & OHLCV_ALL, out);
+  return out;
+}
+
+/**
+ * Reads only some columns of an OHLCV CSV file, inferring its dialect from its first 16 KB.
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+OhlcvColumns read_ohlcv_columns(const std::string &filename, unsigned columns)
+{
+  return read_ohlcv_columns(filename, sniff_csv_file(filename), columns);
+}
+
+/**
+ * Reads some columns of an OHLCV CSV file in a single pass, into segmented
+ * columns.
+ *
+ * The file is read in 1 MB blocks and each row is appended to the
+ * SegmentedColumn of each projected column: no count_lines pre-pass, no
+ * whole-file buffer, and no reallocation copies whatever the file size.
+ *
+ * @param filename Path to the CSV file
+ * @param dialect The dialect of the file (see sniff_csv_file)
+ * @param columns The projected columns (OHLCV_ALL by default)
+ * @return OhlcvSegmentedColumns The projected columns, in file order
+ * @throws same as read_ohlcv_columns
+ *
+ * Example:
+ *   OhlcvSegmentedColumns c = read_ohlcv_segmented("EURUSD.csv", dialect, OHLCV_TIME | OHLCV_CLOSE);
+ *   std::vector<double> closes = c.close.flatten();
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+OhlcvSegmentedColumns read_ohlcv_segmented(const std::string &filename, const CsvDialect &dialect, unsigned columns)
+{
+  TRACE_SCOPE("read_ohlcv_segmented");
+  ColumnReader<OhlcvSegmentedColumns> read = visit_dialect(dialect, ColumnReaderSelector<OhlcvSegmentedColumns>());
+  OhlcvSegmentedColumns out;
+  for_each_row_block(filename, dialect.has_header, [&](const char *begin, const char *end) {
+    read(begin, end, columns & OHLCV_ALL, out);
+    return true;
+  });
+  return out;
+}
+
+/**
+ * Reads some columns of an OHLCV CSV file in a single pass, inferring its dialect from its first 16 KB.
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+OhlcvSegmentedColumns read_ohlcv_segmented(const std::string &filename, unsigned columns)
+{
+  return read_ohlcv_segmented(filename, sniff_csv_file(filename), columns);
+}
+
+int SHOW_read_ohlcv_csv(void)
+{
+  const std::string filename = (std::filesystem::temp_directory_path() / "cpp_utils_ohlcv.csv").string();
+  const int nb_rows = 200'000;
+  {
+    CsvWriter writer(filename, ';', ',');
+    writer.field("Gmt time").field("Open").field("High").field("Low").field("Close").field("Volume");
+    writer.end_row();
+    const auto tp0 = parse_date_time_UTC("01.02.2013 00:00:00.000");
+    for (int i = 0; i < nb_rows; i++) {
+      double price = 1.36115 + (i % 1000) * 1e-5;
+      writer.field(tp0 + std::chrono::minutes(i)).field(price, 5).field(price + 1e-4, 5).field(price - 1e-4, 5);
+      writer.field(price, 5).field((i % 100) * 0.5, 2);
+      writer.end_row();
+    }
+  }
+
+  CsvDialect dialect = sniff_csv_file(filename);
+  std::cout << "Sniffed dialect: delimiter '" << dialect.delimiter << "', decimal separator '" << dialect.decimal_separator
+            << "', header " << (dialect.has_header ? "yes" : "no") << ", quoted " << (dialect.quoted ? "yes" : "no") << std::endl;
+
+  // Generic loader: getline, split, parse_date_time_UTC and parse_double
+  auto start = std::chrono::steady_clock::now();
+  std::vector<OhlcvBar> generic;
+  {
+    std::ifstream file(filename);
+    std::string line;
+    std::getline(file, line);
+    while (std::getline(file, line)) {
+      std::istringstream fields(line);
+      std::string field;
+      OhlcvBar bar;
+      std::getline(fields, field, ';');
+      bar.time = parse_date_time_UTC(field);
+      for (double *value : {&bar.open, &bar.high, &bar.low, &bar.close, &bar.volume}) {
+        std::getline(fields, field, ';');
+        *value = parse_double(field, ',');
+      }
+      generic.push_back(bar);
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> generic_duration = end - start;
+
+  start = std::chrono::steady_clock::now();
+  std::vector<OhlcvBar> bars = read_ohlcv_csv(filename);
+  end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> specialized_duration = end - start;
+
+  std::cout << "Generic loader: " << generic.size() << " bars (in " << generic_duration.count() << " s)" << std::endl;
+  std::cout << "read_ohlcv_csv: " << bars.size() << " bars (in " << specialized_duration.count() << " s)" << std::endl;
+
+  // One week of data: filter after a full read, or push the range down into the scan
+  TimeRange week{parse_date_time_UTC("01.03.2013 00:00:00"), parse_date_time_UTC("08.03.2013 00:00:00")};
+  start = std::chrono::steady_clock::now();
+  std::vector<OhlcvBar> filtered;
+  for (const OhlcvBar &bar : read_ohlcv_csv(filename, dialect)) {
+    if (bar.time >= week.from && bar.time < week.to) {
+      filtered.push_back(bar);
+    }
+  }
+  end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> filter_duration = end - start;
+
+  start = std::chrono::steady_clock::now();
+  std::vector<OhlcvBar> in_range = read_ohlcv_csv(filename, dialect, week);
+  end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> range_duration = end - start;
+
+  std::cout << "One week, read then filter: " << filtered.size() << " bars (in " << filter_duration.count() << " s)" << std::endl;
+  std::cout << "One week, range pushed down: " << in_range.size() << " bars (in " << range_duration.count() << " s)" << std::endl;
+
+  // Only timestamps and closes
+  start = std::chrono::steady_clock::now();
+  OhlcvColumns closes = read_ohlcv_columns(filename, dialect, OHLCV_TIME | OHLCV_CLOSE);
+  end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> projection_duration = end - start;
+  std::cout << "read_ohlcv_columns (time, close): " << closes.close.size() << " rows (in " << projection_duration.count()
+            << " s)" << std::endl;
+
+  // Closes into a std::vector: count_lines pre-pass then reserve, or growth by reallocation; or segmented, in one pass
+  start = std::chrono::steady_clock::now();
+  std::vector<double> counted;
+  counted.reserve(count_lines(filename, true));
+  for (double close : read_ohlcv_columns(filename, dialect, OHLCV_CLOSE).close) {
+    counted.push_back(close);
+  }
+  end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> counted_duration = end - start;
+
+  start = std::chrono::steady_clock::now();
+  std::vector<double> grown;
+  for_each_row_block(filename, true, [&](const char *rows_begin, const char *rows_end) {
+    OhlcvColumns block;
+    visit_dialect(dialect, ColumnReaderSelector<OhlcvColumns>())(rows_begin, rows_end, OHLCV_CLOSE, block);
+    grown.insert(grown.end(), block.close.begin(), block.close.end());
+    return true;
+  });
+  end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> grown_duration = end - start;
+
+  start = std::chrono::steady_clock::now();
+  OhlcvSegmentedColumns segmented = read_ohlcv_segmented(filename, dialect, OHLCV_CLOSE);
+  end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> segmented_duration = end - start;
+
+  std::cout << "Closes, count_lines + reserve: " << counted.size() << " (in " << counted_duration.count() << " s)" << std::endl;
+  std::cout << "Closes, std::vector growth:    " << grown.size() << " (in " << grown_duration.count() << " s)" << std::endl;
+  std::cout << "Closes, read_ohlcv_segmented:  " << segmented.close.size() << " in " << segmented.close.nb_blocks()
+            << " blocks (in " << segmented_duration.count() << " s)" << std::endl;
+
+  std::filesystem::remove(filename);
+  return 0;
+}
+
+// end
@@ -0,0 +1,86 @@
+#ifndef CSV_READER_HPP
+#define CSV_READER_HPP
+
+#include "segmented_column.hpp"
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class TimestampLayout {
+  DMY,                // "DD.MM.YYYY HH:MM:SS[.mmm]", as read by parse_date_time_UTC
+  ISO,                // "YYYY-MM-DD HH:MM:SS[.mmm]" (or 'T' separator, optional 'Z')
+  EPOCH_SECONDS,      // "1359676800"
+  EPOCH_MILLISECONDS, // "1359676800000"
+  UNKNOWN
+};
+
+struct CsvDialect {
+  char delimiter = ';';
+  char decimal_separator = ',';
+  bool quoted = false; // fields may be enclosed in double quotes
+  bool has_header = true;
+  TimestampLayout timestamp_layout = TimestampLayout::DMY;
+};
+
+struct OhlcvBar {
+  std::chrono::system_clock::time_point time;
+  double open = 0.0;
+  double high = 0.0;
+  double low = 0.0;
+  double close = 0.0;
+  double volume = 0.0;
+};
+
+// Columns of an OHLCV file, to be combined with | (e.g. OHLCV_TIME | OHLCV_CLOSE)
+enum OhlcvColumn : unsigned {
+  OHLCV_TIME = 1 << 0,
+  OHLCV_OPEN = 1 << 1,
+  OHLCV_HIGH = 1 << 2,
+  OHLCV_LOW = 1 << 3,
+  OHLCV_CLOSE = 1 << 4,
+  OHLCV_VOLUME = 1 << 5,
+  OHLCV_ALL = (1 << 6) - 1
+};
+
+// One vector per column; the vectors of the columns that are not read stay empty
+struct OhlcvColumns {
+  std::vector<std::chrono::system_clock::time_point> time;
+  std::vector<double> open;
+  std::vector<double> high;
+  std::vector<double> low;
+  std::vector<double> close;
+  std::vector<double> volume;
+};
+
+// Same, in segmented columns (single-pass loading, no relocation)
+struct OhlcvSegmentedColumns {
+  SegmentedColumn<std::chrono::system_clock::time_point> time;
+  SegmentedColumn<double> open;
+  SegmentedColumn<double> high;
+  SegmentedColumn<double> low;
+  SegmentedColumn<double> close;
+  SegmentedColumn<double> volume;
+};
+
+struct TimeRange {
+  std::chrono::system_clock::time_point from; // inclusive
+  std::chrono::system_clock::time_point to;   // exclusive
+  bool sorted = true;                         // rows are in time order: the scan stops at the first row at or after `to`
+};
+
+bool parse_timestamp(std::string_view text, TimestampLayout layout, std::chrono::system_clock::time_point &tp);
+CsvDialect sniff_csv_dialect(std::string_view sample);
+CsvDialect sniff_csv_file(const std::string &filename, size_t sample_size = 16384);
+std::vector<OhlcvBar> read_ohlcv_csv(const std::string &filename);
+std::vector<OhlcvBar> read_ohlcv_csv(const std::string &filename, const CsvDialect &dialect);
+std::vector<OhlcvBar> read_ohlcv_csv(const std::string &filename, const TimeRange &range);
+std::vector<OhlcvBar> read_ohlcv_csv(const std::string &filename, const CsvDialect &dialect, const TimeRange &range);
+OhlcvColumns read_ohlcv_columns(const std::string &filename, unsigned columns);
+OhlcvColumns read_ohlcv_columns(const std::string &filename, const CsvDialect &dialect, unsigned columns);
+OhlcvSegmentedColumns read_ohlcv_segmented(const std::string &filename, unsigned columns = OHLCV_ALL);
+OhlcvSegmentedColumns read_ohlcv_segmented(const std::string &filename, const CsvDialect &dialect, unsigned columns = OHLCV_ALL);
+int SHOW_read_ohlcv_csv(void);
+
+#endif // CSV_READER_HPP
@@ -0,0 +1,192 @@
+#include "csv_time_search.hpp"
+#include "csv_reader.hpp"
+#include "csv_writer.hpp"
+#include "dates_and_times.hpp"
+#include "files_memory_map.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using TimePoint = std::chrono::system_clock::time_point;
+
+// Start of the line following the one containing pos (or text.size())
+size_t next_line_start(std::string_view text, size_t pos)
+{
+  size_t newline = text.find('\n', pos);
+  return (newline == std::string_view::npos) ? text.size() : newline + 1;
+}
+
+// First line start >= pos
+size_t line_start_at_or_after(std::string_view text, size_t pos)
+{
+  return (pos == 0 || text[pos - 1] == '\n') ? pos : next_line_start(text, pos);
+}
+
+bool is_blank_line(std::string_view text, size_t start)
+{
+  for (size_t i = start; i < text.size() && text[i] != '\n'; i++) {
+    if (text[i] != ' ' && text[i] != '\t' && text[i] != '\r') {
+      return false;
+    }
+  }
+  return true;
+}
+
+// First non-blank line start in [start, limit), or limit
+size_t skip_blank_lines(std::string_view text, size_t start, size_t limit)
+{
+  while (start < limit && is_blank_line(text, start)) {
+    start = next_line_start(text, start);
+  }
+  return start < limit ? start : limit;
+}
+
+// Parses only the timestamp (first field) of the row starting at start
+TimePoint row_timestamp(std::string_view text, size_t start, const CsvDialect &dialect)
+{
+  size_t line_end = next_line_start(text, start);
+  std::string_view line = text.substr(start, line_end - start);
+  size_t delimiter = line.find(dialect.delimiter);
+  std::string_view field = line.substr(0, delimiter == std::string_view::npos ? line.size() : delimiter);
+  if (dialect.quoted && field.size() >= 2 && field.front() == '"') {
+    field = field.substr(1, field.find('"', 1) - 1);
+  }
+  TimePoint tp;
+  if (!parse_timestamp(field, dialect.timestamp_layout, tp)) {
+    throw std::runtime_error("Failed to parse datetime: " + std::string(field));
+  }
+  return tp;
+}
+
+} // namespace
+
+/**
+ * Finds, by bisection on byte offsets, the first data row of sorted CSV
+ * text whose timestamp is at or after tp.
+ *
+ * Each step jumps to the middle of the remaining byte range, realigns to
+ * the next line start, and parses only the timestamp of that row (with
+ * parse_timestamp, i.e. parse_date_time_UTC for the default dialect). On
+ * a memory-mapped file, only O(log n) pages are read, and no index is
+ * built. Blank lines are skipped; the header is skipped if
+ * dialect.has_header.
+ *
+ * @param text The CSV text, rows sorted by increasing time (e.g. MemoryMappedFile::view())
+ * @param tp The time to search
+ * @param dialect The dialect of the text (only delimiter, quoting, header and timestamp layout are used)
+ * @return size_t Offset of the start of the row, or text.size() if all rows are before tp
+ * @throws std::runtime_error if a visited row has an invalid timestamp
+ *
+ * Example:
+ *   MemoryMappedFile file("EURUSD.csv");
+ *   size_t offset = find_first_row_at_or_after(file.view(), parse_date_time_UTC("01.03.2013 00:00:00"));
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+size_t find_first_row_at_or_after(std::string_view text, std::chrono::system_clock::time_point tp, const CsvDialect &dialect)
+{
+  size_t lo = skip_blank_lines(text, 0, text.size());
+  if (dialect.has_header && lo < text.size()) {
+    lo = next_line_start(text, lo);
+  }
+  size_t hi = text.size();
+
+  // Invariant: lo is a line start, rows before lo are before tp, the row at hi (if any) is at or after tp
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    size_t row = skip_blank_lines(text, line_start_at_or_after(text, mid), hi);
+    if (row >= hi) {
+      row = skip_blank_lines(text, lo, hi); // no row starts in [mid, hi)
+      if (row >= hi) {
+        lo = hi;
+        break;
+      }
+    }
+    if (row_timestamp(text, row, dialect) >= tp) {
+      hi = row;
+    } else {
+      lo = next_line_start(text, row);
+    }
+  }
+  return skip_blank_lines(text, lo, text.size());
+}
+
+/**
+ * Extracts the rows of sorted CSV text whose timestamp is in [range.from, range.to),
+ * with two binary searches (see find_first_row_at_or_after).
+ *
+ * @param text The CSV text, rows sorted by increasing time
+ * @param range The time range (range.sorted must be true)
+ * @param dialect The dialect of the text
+ * @return std::string_view The rows, as a contiguous part of text
+ * @throws std::invalid_argument if range.sorted is false
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+std::string_view find_rows_between(std::string_view text, const TimeRange &range, const CsvDialect &dialect)
+{
+  if (!range.sorted) {
+    throw std::invalid_argument("find_rows_between requires rows sorted by time");
+  }
+  size_t begin = find_first_row_at_or_after(text, range.from, dialect);
+  if (range.to <= range.from) {
+    return text.substr(begin, 0);
+  }
+  CsvDialect rows_only = dialect;
+  rows_only.has_header = false; // text.substr(begin) starts at a row
+  size_t end = begin + find_first_row_at_or_after(text.substr(begin), range.to, rows_only);
+  return text.substr(begin, end - begin);
+}
+
+int SHOW_find_rows_between(void)
+{
+  const std::string filename = (std::filesystem::temp_directory_path() / "cpp_utils_time_search.csv").string();
+  const int nb_rows = 1'000'000;
+  const TimePoint tp0 = parse_date_time_UTC("01.02.2013 00:00:00.000");
+  {
+    CsvWriter writer(filename, ';', ',');
+    writer.field("Gmt time").field("Open").field("High").field("Low").field("Close").field("Volume");
+    writer.end_row();
+    for (int i = 0; i < nb_rows; i++) {
+      double price = 1.36115 + (i % 1000) * 1e-5;
+      writer.field(tp0 + std::chrono::minutes(i)).field(price, 5).field(price, 5).field(price, 5).field(price, 5).field(1.0, 2);
+      writer.end_row();
+    }
+  }
+
+  // The last hour of data
+  TimeRange range{tp0 + std::chrono::minutes(nb_rows - 60), tp0 + std::chrono::minutes(nb_rows)};
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<OhlcvBar> scanned = read_ohlcv_csv(filename, CsvDialect(), range);
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> scan_duration = end - start;
+
+  std::chrono::duration<double> search_duration;
+  long nb_found = 0;
+  {
+    start = std::chrono::steady_clock::now();
+    MemoryMappedFile file(filename);
+    file.advise(AccessPattern::RANDOM);
+    std::string_view rows = find_rows_between(file.view(), range);
+    end = std::chrono::steady_clock::now();
+    search_duration = end - start;
+    nb_found = std::count(rows.begin(), rows.end(), '\n');
+  }
+
+  std::cout << "Scan with range pushdown: " << scanned.size() << " rows (in " << scan_duration.count() << " s)" << std::endl;
+  std::cout << "find_rows_between:        " << nb_found << " rows (in " << search_duration.count() << " s)" << std::endl;
+
+  std::filesystem::remove(filename);
+  return 0;
+}
+
+// end
@@ -0,0 +1,14 @@
+#ifndef CSV_TIME_SEARCH_HPP
+#define CSV_TIME_SEARCH_HPP
+
+#include "csv_reader.hpp"
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+
+size_t find_first_row_at_or_after(std::string_view text, std::chrono::system_clock::time_point tp,
+                                  const CsvDialect &dialect = CsvDialect());
+std::string_view find_rows_between(std::string_view text, const TimeRange &range, const CsvDialect &dialect = CsvDialect());
+int SHOW_find_rows_between(void);
+
+#endif // CSV_TIME_SEARCH_HPP
@@ -0,0 +1,46 @@
+#ifndef CSV_WRITER_HPP
+#define CSV_WRITER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class CsvWriter {
+public:
+  explicit CsvWriter(const std::string &filename, char delimiter = ';', char decimal_separator = ',',
+                     size_t buffer_size = 1 << 20);
+  explicit CsvWriter(int fd, char delimiter = ';', char decimal_separator = ',', size_t buffer_size = 1 << 20);
+  ~CsvWriter();
+
+  CsvWriter(const CsvWriter &) = delete;
+  CsvWriter &operator=(const CsvWriter &) = delete;
+
+  CsvWriter &field(std::string_view text);
+  CsvWriter &field(long long value);
+  CsvWriter &field(double value, int decimals);
+  CsvWriter &field(const std::chrono::system_clock::time_point &tp, bool with_milliseconds = true);
+  void end_row();
+  void flush();
+
+  uint64_t bytes_written() const { return flushed + used; }
+
+private:
+  char *reserve(size_t size);
+  void start_field();
+
+  int fd = -1;
+  bool owns_fd = false;
+  char delimiter;
+  char decimal_separator;
+  bool row_started = false;
+  std::vector<char> buffer;
+  size_t used = 0;
+  uint64_t flushed = 0;
+};
+
+int SHOW_csv_writer(void);
+
+#endif // CSV_WRITER_HPP
@@ -1,9 +1,11 @@
-#include <algorithm>
+#include "duration.hpp"
+#include "benchmark.hpp"
+#include "benchmark_ab.hpp"
+#include "benchmark_report.hpp"
+#include "stopwatch.hpp"
 #include <chrono>
 #include <iomanip>
 #include <iostream>
-#include <limits>
-#include <vector>
 
 // Helper function to calculate pi using Leibniz formula
 double calculate_pi_leibniz_A(long n)
@@ -32,53 +34,33 @@ int SHOW__measure_duration(void)
 }
 
 /*
- * Execute function 5 times, print each duration, and report the quickest.
+ * Execute function 5 times (after a warm-up run), print each duration, and report statistics,
+ * with hardware counters per term of the series when available and allocations, pinned to the
+ * last CPU, with warnings about a noisy environment.
  */
 void SHOW__benchmark_5_times_A(void)
 {
-  constexpr int nb_runs = 5;
-  std::vector<double> durations;
-  durations.reserve(nb_runs);
-
-  for (int i = 0; i < nb_runs; i++) {
-    auto start = std::chrono::steady_clock::now();
-
-    // The function to benchmark
-    calculate_pi_leibniz_A(100'000'000);
-
-    auto end = std::chrono::steady_clock::now();
-    std::chrono::duration<double> duration = end - start;
-    double duration_sec = duration.count();
-
-    std::cout << "Run " << (i + 1) << " / " << nb_runs << ": "
-              << std::fixed << std::setprecision(6) << duration_sec
-              << " seconds" << std::endl;
-    std::cout.flush();
-    durations.push_back(duration_sec);
-  }
-
-  // Find quickest and slowest
-  double quickest = *std::min_element(durations.begin(), durations.end());
-  double slowest = *std::max_element(durations.begin(), durations.end());
+  BenchmarkOptions options;
+  options.min_runs = 5;
+  options.max_runs = 5;
+  options.verbose = true;
+  options.perf_counters = PERF_ALL; // if permitted
+  options.items_per_run = 100'000'000;
+  options.pin_cpu = last_allowed_cpu(); // away from CPU 0 and its interrupts
+  options.check_environment = true;
+  options.track_allocations = true;
+
+  // The function to benchmark
+  BenchmarkResult result = benchmark([] { return calculate_pi_leibniz_A(100'000'000); }, options);
 
   std::cout << "\nRESULTS:" << std::endl;
-  for (int i = 0; i < nb_runs; i++) {
-    std::cout << "Run " << (i + 1) << " / " << nb_runs << ": "
-              << std::fixed << std::setprecision(6) << durations[i]
-              << " seconds" << std::endl;
-  }
-
-  std::cout << "=> quickest time: " << std::fixed << std::setprecision(6)
-            << quickest << " seconds" << std::endl;
-  std::cout << "=> slowest time:  " << std::fixed << std::setprecision(6)
-            << slowest << " seconds = quickest + "
-            << static_cast<long>(100.0 * (slowest - quickest) / quickest)
-            << " %" << std::endl;
+  print_benchmark_result("calculate_pi_leibniz_A", result);
+  record_benchmark_result("calculate_pi_leibniz_A", result);
 }
 
-double calculate_pi_leibniz_B(long n)
+std::chrono::duration<double> calculate_pi_leibniz_B(long n)
 {
-  auto start = std::chrono::steady_clock::now();
+  Stopwatch sw;
 
   double tmp = 0.0;
   for (long i = 0; i < n; i++) {
@@ -87,55 +69,84 @@ double calculate_pi_leibniz_B(long n)
   }
   tmp = 4.0 * tmp;
 
-  auto end = std::chrono::steady_clock::now();
-  std::chrono::duration<double> duration = end - start;
-  double duration_sec = duration.count();
+  std::chrono::duration<double> duration = sw.elapsed();
 
   std::cout << "Leibniz: pi = " << std::fixed << std::setprecision(6)
-            << tmp << " (in " << duration_sec << " seconds)" << std::endl;
+            << tmp << " (in " << duration.count() << " seconds)" << std::endl;
   std::cout.flush();
-  
-  return duration_sec;
+
+  return duration;
 }
 
 /*
- * Execute function 5 times, print each duration, and report the quickest.
+ * Execute function 5 times (after a warm-up run), print each duration, and report statistics.
  * In this version, the function shall return the execution duration to be benchmarked.
  * This variant enables to do other things in the version, outside of the measured time,
  * for instance printing result.
  */
 void SHOW__benchmark_5_times_B(void)
 {
-  constexpr int nb_runs = 5;
-  std::vector<double> durations;
-  durations.reserve(nb_runs);
-
-  for (int i = 0; i < nb_runs; i++) {
-    double duration = calculate_pi_leibniz_B(100'000'000);
-    std::cout << "Run " << (i + 1) << " / " << nb_runs << ": "
-              << std::fixed << std::setprecision(6) << duration
-              << " seconds" << std::endl;
-    std::cout.flush();
-    durations.push_back(duration);
-  }
+  BenchmarkOptions options;
+  options.min_runs = 5;
+  options.max_runs = 5;
+  options.verbose = true;
 
-  // Find quickest and slowest
-  double quickest = *std::min_element(durations.begin(), durations.end());
-  double slowest = *std::max_element(durations.begin(), durations.end());
+  BenchmarkResult result = benchmark([] { return calculate_pi_leibniz_B(100'000'000); }, options);
 
   std::cout << "\nRESULTS:" << std::endl;
-  for (int i = 0; i < nb_runs; i++) {
-    std::cout << "Run " << (i + 1) << " / " << nb_runs << ": "
-              << std::fixed << std::setprecision(6) << durations[i]
-              << " seconds" << std::endl;
+  print_benchmark_result("calculate_pi_leibniz_B", result);
+  record_benchmark_result("calculate_pi_leibniz_B", result);
+}
+
+namespace {
+
+// Leibniz formula, sign computed for each term (as calculate_pi_leibniz_A, without printing)
+double leibniz_with_sign(long n)
+{
+  double tmp = 0.0;
+  for (long i = 0; i < n; i++) {
+    double sign = (i % 2 == 0) ? 1.0 : -1.0;
+    tmp += sign / (2.0 * i + 1.0);
+  }
+  return 4.0 * tmp;
+}
+
+// Same, two terms per iteration: no sign to compute
+double leibniz_by_pairs(long n)
+{
+  double tmp = 0.0;
+  long i = 0;
+  for (; i + 1 < n; i += 2) {
+    tmp += 1.0 / (2.0 * i + 1.0) - 1.0 / (2.0 * i + 3.0);
   }
+  if (i < n) {
+    tmp += 1.0 / (2.0 * i + 1.0);
+  }
+  return 4.0 * tmp;
+}
 
-  std::cout << "=> quickest time: " << std::fixed << std::setprecision(6)
-            << quickest << " seconds" << std::endl;
-  std::cout << "=> slowest time:  " << std::fixed << std::setprecision(6)
-            << slowest << " seconds = quickest + "
-            << static_cast<long>(100.0 * (slowest - quickest) / quickest)
-            << " %" << std::endl;
+} // namespace
+
+/*
+ * Is an optimization real? Interleaved runs of two variants, and a verdict from a bootstrap
+ * interval of the ratio of medians and a Mann-Whitney U test, instead of eyeballing two
+ * separate benchmarks.
+ */
+void SHOW__benchmark_A_versus_B(void)
+{
+  ABOptions options;
+  options.min_pairs = 20;
+  options.max_pairs = 100;
+  options.max_seconds = 10.0;
+
+  ABResult result = benchmark_ab([] { return leibniz_with_sign(20'000'000); },
+                                 [] { return leibniz_by_pairs(20'000'000); }, options);
+  print_ab_result("sign per term", "two terms per iteration", result);
+
+  // The same variant on both sides: no difference expected
+  result = benchmark_ab([] { return leibniz_with_sign(20'000'000); }, [] { return leibniz_with_sign(20'000'000); },
+                        options);
+  print_ab_result("sign per term", "sign per term", result);
 }
 
 // end
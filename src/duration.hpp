@@ -4,6 +4,7 @@
 int SHOW__measure_duration(void);
 void SHOW__benchmark_5_times_A(void);
 void SHOW__benchmark_5_times_B(void);
+void SHOW__benchmark_A_versus_B(void);
 
 #endif // MEASURE_DURATION_HPP
 
@@ -0,0 +1,842 @@
+#include "files_block_reader.hpp"
+#include "files.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define FILES_BLOCK_READER_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+namespace {
+
+// Read-only file with positional reads (pread on POSIX, seek + fread on Windows).
+class InputFile {
+public:
+  explicit InputFile(const std::string &filename)
+  {
+#if defined(_WIN32)
+    file = std::fopen(filename.c_str(), "rb");
+    if (file == nullptr) {
+      throw std::runtime_error("Cannot open file: " + filename);
+    }
+    _fseeki64(file, 0, SEEK_END);
+    file_size = static_cast<uint64_t>(_ftelli64(file));
+#else
+    fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::runtime_error("Cannot open file: " + filename);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      throw std::runtime_error("Cannot stat file: " + filename);
+    }
+    file_size = static_cast<uint64_t>(st.st_size);
+#if defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#endif
+  }
+
+  ~InputFile()
+  {
+#if defined(_WIN32)
+    std::fclose(file);
+#else
+    ::close(fd);
+#endif
+  }
+
+  InputFile(const InputFile &) = delete;
+  InputFile &operator=(const InputFile &) = delete;
+
+  uint64_t size() const { return file_size; }
+
+#if !defined(_WIN32)
+  int native_handle() const { return fd; }
+#endif
+
+  // Returns the number of bytes read (0 at end of file), or -1 on error.
+  long long read_at(char *buffer, size_t length, uint64_t offset)
+  {
+#if defined(_WIN32)
+    if (_fseeki64(file, static_cast<long long>(offset), SEEK_SET) != 0) {
+      return -1;
+    }
+    size_t n = std::fread(buffer, 1, length, file);
+    return (n == 0 && std::ferror(file)) ? -1 : static_cast<long long>(n);
+#else
+    while (true) {
+      ssize_t n = ::pread(fd, buffer, length, static_cast<off_t>(offset));
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      return static_cast<long long>(n);
+    }
+#endif
+  }
+
+private:
+#if defined(_WIN32)
+  std::FILE *file = nullptr;
+#else
+  int fd = -1;
+#endif
+  uint64_t file_size = 0;
+};
+
+#if defined(FILES_BLOCK_READER_HAS_IO_URING)
+
+// Minimal io_uring wrapper on raw system calls (no liburing dependency).
+class IoUring {
+public:
+  explicit IoUring(unsigned entries)
+  {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    ring_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (ring_fd < 0) {
+      throw std::runtime_error("io_uring_setup failed: " + std::string(std::strerror(errno)));
+    }
+
+    sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+      sq_size = cq_size = std::max(sq_size, cq_size);
+    }
+
+    sq_ptr = ::mmap(nullptr, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+    cq_ptr = single_mmap ? sq_ptr : ::mmap(nullptr, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ptr = ::mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+    if (sq_ptr == MAP_FAILED || cq_ptr == MAP_FAILED || sqes_ptr == MAP_FAILED) {
+      release();
+      throw std::runtime_error("io_uring mmap failed");
+    }
+
+    char *sq = static_cast<char *>(sq_ptr);
+    char *cq = static_cast<char *>(cq_ptr);
+    sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    sqes = static_cast<io_uring_sqe *>(sqes_ptr);
+  }
+
+  ~IoUring()
+  {
+    // The kernel may still write into the caller's buffers: drain before unmapping.
+    try {
+      uint64_t user_data;
+      int res;
+      while (in_flight > 0) {
+        wait(user_data, res);
+      }
+    } catch (...) {
+    }
+    release();
+  }
+
+  IoUring(const IoUring &) = delete;
+  IoUring &operator=(const IoUring &) = delete;
+
+  void submit_readv(int fd, const iovec *iov, uint64_t offset, uint64_t user_data)
+  {
+    unsigned tail = *sq_tail; // only this thread writes the tail
+    unsigned index = tail & *sq_mask;
+    io_uring_sqe &sqe = sqes[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_READV;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<uint64_t>(iov);
+    sqe.len = 1;
+    sqe.off = offset;
+    sqe.user_data = user_data;
+    sq_array[index] = index;
+    __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    while (::syscall(__NR_io_uring_enter, ring_fd, 1, 0, 0, nullptr, 0) < 0) {
+      if (errno != EINTR) {
+        throw std::runtime_error("io_uring_enter failed: " + std::string(std::strerror(errno)));
+      }
+    }
+    in_flight++;
+  }
+
+  void wait(uint64_t &user_data, int &res)
+  {
+    while (true) {
+      unsigned head = *cq_head; // only this thread writes the head
+      unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+      if (head != tail) {
+        const io_uring_cqe &cqe = cqes[head & *cq_mask];
+        user_data = cqe.user_data;
+        res = cqe.res;
+        __atomic_store_n(cq_head, head + 1, __ATOMIC_RELEASE);
+        in_flight--;
+        return;
+      }
+      if (::syscall(__NR_io_uring_enter, ring_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR) {
+        throw std::runtime_error("io_uring_enter failed: " + std::string(std::strerror(errno)));
+      }
+    }
+  }
+
+private:
+  void release()
+  {
+    if (sqes_ptr != MAP_FAILED) {
+      ::munmap(sqes_ptr, sqes_size);
+    }
+    if (cq_ptr != MAP_FAILED && !single_mmap) {
+      ::munmap(cq_ptr, cq_size);
+    }
+    if (sq_ptr != MAP_FAILED) {
+      ::munmap(sq_ptr, sq_size);
+    }
+    ::close(ring_fd);
+  }
+
+  int ring_fd = -1;
+  bool single_mmap = false;
+  unsigned in_flight = 0;
+  void *sq_ptr = MAP_FAILED;
+  void *cq_ptr = MAP_FAILED;
+  void *sqes_ptr = MAP_FAILED;
+  size_t sq_size = 0;
+  size_t cq_size = 0;
+  size_t sqes_size = 0;
+  unsigned *sq_tail = nullptr;
+  unsigned *sq_mask = nullptr;
+  unsigned *sq_array = nullptr;
+  unsigned *cq_head = nullptr;
+  unsigned *cq_tail = nullptr;
+  unsigned *cq_mask = nullptr;
+  io_uring_cqe *cqes = nullptr;
+  io_uring_sqe *sqes = nullptr;
+};
+
+// Returns false if io_uring is not usable and nothing has been delivered yet,
+// so that the caller can fall back to the pread thread.
+bool read_with_io_uring(InputFile &file, const BlockCallback &on_block, const BlockReaderOptions &options)
+{
+  struct Slot {
+    std::vector<char> buffer;
+    iovec iov;
+    uint64_t offset = 0;
+    size_t length = 0;
+    size_t filled = 0;
+    bool ready = false;
+  };
+
+  const int nb_buffers = std::max(options.nb_buffers, 2);
+  const uint64_t file_size = file.size();
+  std::vector<Slot> slots(nb_buffers);
+  for (Slot &slot : slots) {
+    slot.buffer.resize(options.block_size);
+  }
+
+  // Declared after the buffers so that it is destroyed (and drained) first.
+  std::unique_ptr<IoUring> ring;
+  try {
+    ring = std::make_unique<IoUring>(static_cast<unsigned>(nb_buffers));
+  } catch (const std::runtime_error &) {
+    return false;
+  }
+
+  uint64_t next_offset = 0;
+  bool delivered = false;
+  std::deque<int> order; // slots in file order
+
+  auto submit_remainder = [&](int s) {
+    Slot &slot = slots[s];
+    slot.iov.iov_base = slot.buffer.data() + slot.filled;
+    slot.iov.iov_len = slot.length - slot.filled;
+    ring->submit_readv(file.native_handle(), &slot.iov, slot.offset + slot.filled, static_cast<uint64_t>(s));
+  };
+
+  auto submit = [&](int s) {
+    Slot &slot = slots[s];
+    slot.offset = next_offset;
+    slot.length = static_cast<size_t>(std::min<uint64_t>(options.block_size, file_size - next_offset));
+    slot.filled = 0;
+    slot.ready = false;
+    next_offset += slot.length;
+    submit_remainder(s);
+    order.push_back(s);
+  };
+
+  for (int s = 0; s < nb_buffers && next_offset < file_size; s++) {
+    submit(s);
+  }
+
+  while (!order.empty()) {
+    int s = order.front();
+    while (!slots[s].ready) {
+      uint64_t user_data;
+      int res;
+      ring->wait(user_data, res);
+      Slot &done = slots[user_data];
+      if (res == -EINTR || res == -EAGAIN) {
+        submit_remainder(static_cast<int>(user_data));
+      } else if (res < 0) {
+        if (!delivered) {
+          return false;
+        }
+        throw std::runtime_error("Read failed: " + std::string(std::strerror(-res)));
+      } else {
+        done.filled += static_cast<size_t>(res);
+        if (res == 0 || done.filled == done.length) {
+          done.ready = true;
+        } else {
+          submit_remainder(static_cast<int>(user_data)); // short read
+        }
+      }
+    }
+
+    on_block(slots[s].buffer.data(), slots[s].filled, slots[s].offset);
+    delivered = true;
+    order.pop_front();
+    if (next_offset < file_size) {
+      submit(s);
+    }
+  }
+  return true;
+}
+
+#endif // FILES_BLOCK_READER_HAS_IO_URING
+
+void read_with_thread(InputFile &file, const BlockCallback &on_block, const BlockReaderOptions &options)
+{
+  struct Slot {
+    std::vector<char> buffer;
+    uint64_t offset = 0;
+    size_t size = 0;
+  };
+
+  const int nb_buffers = std::max(options.nb_buffers, 2);
+  const uint64_t file_size = file.size();
+  std::vector<Slot> slots(nb_buffers);
+  std::deque<int> free_slots;
+  std::deque<int> full_slots;
+  for (int s = 0; s < nb_buffers; s++) {
+    slots[s].buffer.resize(options.block_size);
+    free_slots.push_back(s);
+  }
+
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool stop = false;
+  bool finished = false;
+  std::exception_ptr error;
+
+  std::thread producer([&]() {
+    uint64_t offset = 0;
+    while (offset < file_size) {
+      int s;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [&] { return !free_slots.empty() || stop; });
+        if (stop) {
+          break;
+        }
+        s = free_slots.front();
+        free_slots.pop_front();
+      }
+
+      Slot &slot = slots[s];
+      size_t length = static_cast<size_t>(std::min<uint64_t>(options.block_size, file_size - offset));
+      size_t filled = 0;
+      bool failed = false;
+      while (filled < length) {
+        long long n = file.read_at(slot.buffer.data() + filled, length - filled, offset + filled);
+        if (n < 0) {
+          failed = true;
+          break;
+        }
+        if (n == 0) {
+          break; // file shrank
+        }
+        filled += static_cast<size_t>(n);
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (failed) {
+        error = std::make_exception_ptr(std::runtime_error("Read failed: " + std::string(std::strerror(errno))));
+        break;
+      }
+      slot.offset = offset;
+      slot.size = filled;
+      full_slots.push_back(s);
+      cond.notify_all();
+      if (filled < length) {
+        break;
+      }
+      offset += length;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    finished = true;
+    cond.notify_all();
+  });
+
+  // Stops and joins the producer even if on_block throws
+  struct Joiner {
+    std::thread &thread;
+    std::mutex &mutex;
+    std::condition_variable &cond;
+    bool &stop;
+    ~Joiner()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+      }
+      cond.notify_all();
+      thread.join();
+    }
+  } joiner{producer, mutex, cond, stop};
+
+  while (true) {
+    int s;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cond.wait(lock, [&] { return !full_slots.empty() || finished; });
+      if (full_slots.empty()) {
+        break;
+      }
+      s = full_slots.front();
+      full_slots.pop_front();
+    }
+
+    on_block(slots[s].buffer.data(), slots[s].size, slots[s].offset);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    free_slots.push_back(s);
+    cond.notify_all();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+// Length of the prefix of [p, p + n) made of ASCII bytes other than '\r',
+// which need neither validation nor normalization
+size_t plain_run(const char *p, size_t n)
+{
+  size_t i = 0;
+#if defined(__AVX2__)
+  const __m256i cr = _mm256_set1_epi8('\r');
+  for (; i + 32 <= n; i += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(v)) |
+                    static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, cr)));
+    if (mask != 0) {
+      return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+#elif defined(__SSE2__)
+  const __m128i cr = _mm_set1_epi8('\r');
+  for (; i + 16 <= n; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(v)) |
+                    static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, cr)));
+    if (mask != 0) {
+      return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+#endif
+  while (i < n && static_cast<unsigned char>(p[i]) < 0x80 && p[i] != '\r') {
+    i++;
+  }
+  return i;
+}
+
+// Streaming UTF-8 validation and BOM/CRLF normalization: sequences and CRLF
+// pairs may straddle blocks. Invalid sequences are reported, and passed through.
+class TextNormalizer {
+public:
+  explicit TextNormalizer(TextReport &report) : report(report) {}
+
+  // Normalizes the block at file offset `offset` into out
+  void process(const char *data, size_t size, uint64_t offset, std::string &out)
+  {
+    out.clear();
+    if (bom_undecided) {
+      // The BOM may span blocks: keep the leading bytes until 3 are known
+      // or they stop matching it
+      size_t take = std::min(size, 3 - head.size());
+      head.append(data, take);
+      data += take;
+      size -= take;
+      offset += take;
+      if (head.size() < 3 && std::memcmp(head.data(), "\xEF\xBB\xBF", head.size()) == 0) {
+        return;
+      }
+      bom_undecided = false;
+      if (head == "\xEF\xBB\xBF") {
+        report.had_bom = true;
+      } else {
+        normalize(head.data(), head.size(), 0, out);
+      }
+    }
+    normalize(data, size, offset, out);
+  }
+
+  // Flushes the state at end of file into out
+  void finish(std::string &out)
+  {
+    out.clear();
+    if (bom_undecided) { // file shorter than a BOM
+      bom_undecided = false;
+      normalize(head.data(), head.size(), 0, out);
+    }
+    if (pending_cr) {
+      out += '\r';
+      pending_cr = false;
+    }
+    if (nb_expected > 0) {
+      invalid(sequence_start); // truncated sequence
+      nb_expected = 0;
+    }
+  }
+
+private:
+  // Appends the normalized bytes at file offset `offset` to out
+  void normalize(const char *data, size_t size, uint64_t offset, std::string &out)
+  {
+    if (pending_cr && size > 0) {
+      pending_cr = false;
+      if (data[0] == '\n') {
+        report.nb_crlf++;
+      } else {
+        out += '\r';
+      }
+    }
+
+    size_t i = 0;
+    while (i < size) {
+      if (nb_expected == 0) {
+        size_t run = plain_run(data + i, size - i);
+        out.append(data + i, run);
+        i += run;
+        if (i == size) {
+          break;
+        }
+      }
+      unsigned char c = static_cast<unsigned char>(data[i]);
+      validate(c, offset + i);
+      if (c == '\r') {
+        if (i + 1 == size) {
+          pending_cr = true; // decided with the next block
+          i++;
+          continue;
+        }
+        if (data[i + 1] == '\n') {
+          report.nb_crlf++;
+          i++;
+          continue;
+        }
+      }
+      out += static_cast<char>(c);
+      i++;
+    }
+  }
+
+  void validate(unsigned char c, uint64_t offset)
+  {
+    if (nb_expected > 0) {
+      if (c >= lower && c <= upper) {
+        nb_expected--;
+        lower = 0x80;
+        upper = 0xBF;
+        return;
+      }
+      invalid(sequence_start); // c may start a new sequence
+      nb_expected = 0;
+    }
+
+    sequence_start = offset;
+    lower = 0x80;
+    upper = 0xBF;
+    if (c < 0x80) {
+      return;
+    } else if (c >= 0xC2 && c <= 0xDF) {
+      nb_expected = 1;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+      nb_expected = 2;
+      if (c == 0xE0) {
+        lower = 0xA0; // overlong
+      } else if (c == 0xED) {
+        upper = 0x9F; // surrogates
+      }
+    } else if (c >= 0xF0 && c <= 0xF4) {
+      nb_expected = 3;
+      if (c == 0xF0) {
+        lower = 0x90; // overlong
+      } else if (c == 0xF4) {
+        upper = 0x8F; // above U+10FFFF
+      }
+    } else {
+      invalid(offset);
+    }
+  }
+
+  void invalid(uint64_t offset)
+  {
+    report.nb_invalid++;
+    if (report.invalid_offsets.size() < 100) {
+      report.invalid_offsets.push_back(offset);
+    }
+  }
+
+  TextReport &report;
+  int nb_expected = 0; // continuation bytes still expected
+  unsigned char lower = 0x80;
+  unsigned char upper = 0xBF;
+  uint64_t sequence_start = 0;
+  bool pending_cr = false;
+  bool bom_undecided = true;
+  std::string head; // leading bytes, while bom_undecided
+};
+
+} // namespace
+
+/**
+ * Reads a file sequentially by large blocks, with several reads in flight,
+ * and hands each filled buffer to a callback.
+ *
+ * While the callback processes one block, the next (nb_buffers - 1) blocks
+ * are being read, so that CPU work overlaps with disk latency
+ * (double-buffering with nb_buffers = 2, triple-buffering with 3, ...).
+ *
+ * On Linux, reads are submitted through io_uring (raw system calls, no
+ * liburing dependency). If io_uring is unavailable (old kernel, seccomp,
+ * other platform) or disabled in the options, a background thread reads
+ * the blocks with pread while the calling thread consumes them.
+ *
+ * The callback is always invoked on the calling thread, in file order.
+ * The buffer is only valid during the call and is reused afterwards.
+ *
+ * @param filename Path to the file to read
+ * @param on_block Callback receiving (data, size, offset in file) for each block
+ * @param options Block size, number of buffers, and backend selection
+ * @return std::string Name of the backend used: "io_uring" or "pread thread"
+ * @throws std::runtime_error if the file cannot be opened or a read fails
+ *
+ * Example:
+ *   size_t bytes = 0;
+ *   read_file_by_blocks("data.csv", [&](const char *, size_t size, uint64_t) { bytes += size; });
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+std::string read_file_by_blocks(const std::string &filename, const BlockCallback &on_block, const BlockReaderOptions &options)
+{
+  if (options.block_size == 0) {
+    throw std::invalid_argument("Block size must be positive");
+  }
+
+  InputFile file(filename);
+
+#if defined(FILES_BLOCK_READER_HAS_IO_URING)
+  if (options.use_io_uring && read_with_io_uring(file, on_block, options)) {
+    return "io_uring";
+  }
+#endif
+
+  read_with_thread(file, on_block, options);
+  return "pread thread";
+}
+
+/**
+ * Reads a text file by blocks, like read_file_by_blocks, validating UTF-8
+ * and normalizing line endings on the fly, in the same pass.
+ *
+ * A leading UTF-8 BOM is stripped and CRLF line endings become LF (a lone
+ * '\r' is kept), even when split across blocks. Invalid UTF-8 sequences
+ * (bad bytes, overlong forms, surrogates, truncated sequences) are counted
+ * and their file offsets reported, instead of throwing; their bytes are
+ * passed through unchanged. Runs of plain ASCII, the common case, are
+ * skipped 32 bytes at a time with AVX2 (16 with SSE2) and copied in bulk.
+ *
+ * The callback receives normalized text, so sizes may differ from the
+ * file's; offset is the file offset of the block the text comes from.
+ *
+ * @param filename Path to the file to read
+ * @param on_block Callback receiving (normalized data, size, file offset)
+ * @param options Block size, number of buffers, and backend selection
+ * @return TextReport What was normalized, and the invalid sequences
+ * @throws std::runtime_error if the file cannot be opened or a read fails
+ *
+ * Example:
+ *   TextReport report = read_text_file_by_blocks("vendor.csv", [&](const char *data, size_t size, uint64_t) { ... });
+ *   if (report.nb_invalid > 0) { ... report.invalid_offsets[0] ... }
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+TextReport read_text_file_by_blocks(const std::string &filename, const BlockCallback &on_block, const BlockReaderOptions &options)
+{
+  TextReport report;
+  TextNormalizer normalizer(report);
+  std::string text;
+  text.reserve(options.block_size + 3); // + undecided BOM bytes, pending CR
+  uint64_t end_offset = 0;
+
+  read_file_by_blocks(filename, [&](const char *data, size_t size, uint64_t offset) {
+    normalizer.process(data, size, offset, text);
+    end_offset = offset + size;
+    if (!text.empty()) {
+      on_block(text.data(), text.size(), offset);
+    }
+  }, options);
+
+  normalizer.finish(text);
+  if (!text.empty()) {
+    on_block(text.data(), text.size(), end_offset - text.size());
+  }
+  return report;
+}
+
+/**
+ * Counts the number of non-empty data lines in a file, like count_lines,
+ * but scans blocks with memchr while the next blocks are being read.
+ *
+ * @param filename Path to the file to count lines in
+ * @param skipHeader If true, subtracts 1 from the count to exclude the header line
+ * @return size_t Number of non-empty lines (excluding header if specified)
+ * @throws std::runtime_error if the file cannot be opened
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+size_t count_lines_async(const std::string &filename, bool skipHeader)
+{
+  size_t count = 0;
+  char previous = '\n'; // last byte of the previous block
+
+  read_file_by_blocks(filename, [&](const char *data, size_t size, uint64_t) {
+    const char *p = data;
+    const char *end = data + size;
+    while (p < end) {
+      const char *newline = static_cast<const char *>(std::memchr(p, '\n', end - p));
+      if (newline == nullptr) {
+        break;
+      }
+      char before = (newline == data) ? previous : newline[-1];
+      if (before != '\n') {
+        count++;
+      }
+      p = newline + 1;
+    }
+    if (size > 0) {
+      previous = data[size - 1];
+    }
+  });
+
+  if (previous != '\n') {
+    count++; // last line without trailing newline
+  }
+
+  if (skipHeader && count > 0)
+    count--;
+  return count;
+}
+
+int SHOW_read_file_by_blocks(void)
+{
+  const std::string filename = "./src/main.cpp";
+
+  auto start = std::chrono::steady_clock::now();
+  size_t nb_lines = count_lines(filename, false);
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> duration = end - start;
+  std::cout << "count_lines:       " << nb_lines << " lines (in " << duration.count() << " s)" << std::endl;
+
+  start = std::chrono::steady_clock::now();
+  nb_lines = count_lines_async(filename, false);
+  end = std::chrono::steady_clock::now();
+  duration = end - start;
+  std::cout << "count_lines_async: " << nb_lines << " lines (in " << duration.count() << " s)" << std::endl;
+
+  size_t nb_blocks = 0;
+  BlockReaderOptions options;
+  options.block_size = 4096;
+  std::string backend = read_file_by_blocks(filename, [&](const char *, size_t, uint64_t) { nb_blocks++; }, options);
+  std::cout << "Read " << nb_blocks << " blocks of " << options.block_size << " bytes with " << backend << std::endl;
+
+  return 0;
+}
+
+int SHOW_read_text_file_by_blocks(void)
+{
+  const std::string filename = (std::filesystem::temp_directory_path() / "cpp_utils_text_blocks.csv").string();
+  {
+    std::ofstream file(filename, std::ios::binary);
+    file << "\xEF\xBB\xBFGmt time;Close;Comment\r\n";
+    for (int i = 0; i < 1'000'000; i++) {
+      file << "01.02.2013 00:00:00.000;1,36115;" << (i % 1000 == 0 ? "caf\xC3\xA9" : "ok") << "\r\n";
+    }
+    file << "01.02.2013 00:00:00.000;1,36115;bad \xC3\x28\r\n"; // invalid sequence
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  uint64_t raw_bytes = 0;
+  read_file_by_blocks(filename, [&](const char *, size_t size, uint64_t) { raw_bytes += size; });
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> raw_duration = end - start;
+
+  start = std::chrono::steady_clock::now();
+  uint64_t text_bytes = 0;
+  TextReport report = read_text_file_by_blocks(filename, [&](const char *, size_t size, uint64_t) { text_bytes += size; });
+  end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> text_duration = end - start;
+
+  std::cout << "read_file_by_blocks:      " << raw_bytes << " bytes (in " << raw_duration.count() << " s, "
+            << raw_bytes / raw_duration.count() / 1e6 << " MB/s)" << std::endl;
+  std::cout << "read_text_file_by_blocks: " << text_bytes << " bytes (in " << text_duration.count() << " s, "
+            << raw_bytes / text_duration.count() / 1e6 << " MB/s)" << std::endl;
+  std::cout << "BOM: " << (report.had_bom ? "stripped" : "none") << ", CRLF converted: " << report.nb_crlf
+            << ", invalid UTF-8 sequences: " << report.nb_invalid;
+  if (!report.invalid_offsets.empty()) {
+    std::cout << " (first at offset " << report.invalid_offsets[0] << ")";
+  }
+  std::cout << std::endl;
+
+  std::filesystem::remove(filename);
+  return 0;
+}
+
+// end
@@ -0,0 +1,33 @@
+#ifndef FILES_BLOCK_READER_HPP
+#define FILES_BLOCK_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct BlockReaderOptions {
+  size_t block_size = 1 << 20; // bytes requested per read
+  int nb_buffers = 3;          // 2 = double-buffering, 3 = triple-buffering, ...
+  bool use_io_uring = true;    // if false or unavailable, a pread thread is used
+};
+
+struct TextReport {
+  bool had_bom = false;                  // a UTF-8 byte order mark was stripped
+  uint64_t nb_crlf = 0;                  // CRLF line endings converted to LF
+  uint64_t nb_invalid = 0;               // invalid UTF-8 sequences (passed through unchanged)
+  std::vector<uint64_t> invalid_offsets; // file offsets of the first 100 of them
+};
+
+using BlockCallback = std::function<void(const char *data, size_t size, uint64_t offset)>;
+
+std::string read_file_by_blocks(const std::string &filename, const BlockCallback &on_block,
+                                const BlockReaderOptions &options = BlockReaderOptions());
+TextReport read_text_file_by_blocks(const std::string &filename, const BlockCallback &on_block,
+                                   const BlockReaderOptions &options = BlockReaderOptions());
+size_t count_lines_async(const std::string &filename, bool skipHeader);
+int SHOW_read_file_by_blocks(void);
+int SHOW_read_text_file_by_blocks(void);
+
+#endif // FILES_BLOCK_READER_HPP
@@ -0,0 +1,386 @@
+#include "files_line_index.hpp"
+#include "files_block_reader.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const char LINE_INDEX_MAGIC[8] = {'C', 'P', 'P', 'U', 'L', 'I', 'D', 'X'};
+const uint64_t LINE_INDEX_VERSION = 1;
+
+int64_t last_write_ticks(const std::string &filename)
+{
+  std::error_code ec;
+  auto mtime = std::filesystem::last_write_time(filename, ec);
+  return ec ? 0 : static_cast<int64_t>(mtime.time_since_epoch().count());
+}
+
+void put_u64(std::string &out, uint64_t value)
+{
+  for (int i = 0; i < 8; i++) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+// LEB128: 7 bits per byte, high bit set when more bytes follow
+void put_varint(std::string &out, uint64_t value)
+{
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+bool get_u64(const std::string &in, size_t &pos, uint64_t &value)
+{
+  if (in.size() - pos < 8) {
+    return false;
+  }
+  value = 0;
+  for (int i = 0; i < 8; i++) {
+    value |= static_cast<uint64_t>(static_cast<unsigned char>(in[pos++])) << (8 * i);
+  }
+  return true;
+}
+
+bool get_varint(const std::string &in, size_t &pos, uint64_t &value)
+{
+  value = 0;
+  for (int shift = 0; shift < 64 && pos < in.size(); shift += 7) {
+    unsigned char byte = static_cast<unsigned char>(in[pos++]);
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Opens the file and positions it at the start of the given line
+void seek_to_line(std::ifstream &file, const LineIndex &index, const std::string &filename, uint64_t line)
+{
+  if (line >= index.nb_lines) {
+    throw std::out_of_range("Line " + std::to_string(line) + " is beyond end of file: " + filename);
+  }
+
+  file.open(filename, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+
+  file.seekg(static_cast<std::streamoff>(index.offsets[line / index.stride]));
+  for (uint64_t i = line % index.stride; i > 0; i--) {
+    file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  }
+}
+
+} // namespace
+
+/**
+ * Builds a line-offset index of a text file, in a single pass that also
+ * counts its lines.
+ *
+ * The byte offset of every `stride`-th line is recorded, so that seeking
+ * to any line costs one index lookup plus a scan of at most (stride - 1)
+ * lines. The file is read with read_file_by_blocks and newlines are found
+ * with memchr.
+ *
+ * Lines are numbered from 0 and include empty lines (physical lines);
+ * nb_non_empty_lines gives the same result as count_lines(filename, false).
+ *
+ * @param filename Path to the file to index
+ * @param stride Number of lines between two recorded offsets (K)
+ * @return LineIndex The index, stamped with the size and last write time of the file
+ * @throws std::invalid_argument if stride is 0
+ * @throws std::runtime_error if the file cannot be opened
+ *
+ * Example:
+ *   LineIndex index = build_line_index("data.csv", 1024);
+ *   std::vector<std::string> rows = read_lines(index, "data.csv", 1000000, 1000010);
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+LineIndex build_line_index(const std::string &filename, uint64_t stride)
+{
+  if (stride == 0) {
+    throw std::invalid_argument("Line index stride must be positive");
+  }
+
+  LineIndex index;
+  index.stride = stride;
+  index.file_mtime = last_write_ticks(filename); // before reading, so that a concurrent write makes the index stale
+  index.offsets.push_back(0);
+
+  uint64_t nb_newlines = 0;
+  uint64_t until_next_record = stride;
+  char previous = '\n'; // last byte of the previous block
+
+  read_file_by_blocks(filename, [&](const char *data, size_t size, uint64_t offset) {
+    const char *p = data;
+    const char *end = data + size;
+    while (p < end) {
+      const char *newline = static_cast<const char *>(std::memchr(p, '\n', end - p));
+      if (newline == nullptr) {
+        break;
+      }
+      char before = (newline == data) ? previous : newline[-1];
+      if (before != '\n') {
+        index.nb_non_empty_lines++;
+      }
+      nb_newlines++;
+      if (--until_next_record == 0) {
+        index.offsets.push_back(offset + static_cast<uint64_t>(newline - data) + 1);
+        until_next_record = stride;
+      }
+      p = newline + 1;
+    }
+    if (size > 0) {
+      previous = data[size - 1];
+    }
+    index.file_size = offset + size;
+  });
+
+  index.nb_lines = nb_newlines;
+  if (previous != '\n') {
+    index.nb_lines++; // last line without trailing newline
+    index.nb_non_empty_lines++;
+  }
+
+  // A line cannot start at the end of the file
+  while (!index.offsets.empty() && index.offsets.back() >= index.file_size) {
+    index.offsets.pop_back();
+  }
+
+  return index;
+}
+
+/**
+ * Writes a line index to a compact sidecar file.
+ *
+ * Format: 8-byte magic, version, file size, last write time, stride,
+ * number of lines, number of non-empty lines, number of offsets (all as
+ * little-endian 64-bit integers), then the offsets delta-encoded as LEB128
+ * varints (usually 2 or 3 bytes per recorded line).
+ *
+ * @param index The index to save
+ * @param index_filename Path to the sidecar file (conventionally filename + ".lidx")
+ * @throws std::runtime_error if the sidecar file cannot be written
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+void save_line_index(const LineIndex &index, const std::string &index_filename)
+{
+  std::string out(LINE_INDEX_MAGIC, sizeof(LINE_INDEX_MAGIC));
+  put_u64(out, LINE_INDEX_VERSION);
+  put_u64(out, index.file_size);
+  put_u64(out, static_cast<uint64_t>(index.file_mtime));
+  put_u64(out, index.stride);
+  put_u64(out, index.nb_lines);
+  put_u64(out, index.nb_non_empty_lines);
+  put_u64(out, index.offsets.size());
+
+  uint64_t previous = 0;
+  for (uint64_t offset : index.offsets) {
+    put_varint(out, offset - previous);
+    previous = offset;
+  }
+
+  std::ofstream file(index_filename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    throw std::runtime_error("Cannot open file: " + index_filename);
+  }
+  file.write(out.data(), static_cast<std::streamsize>(out.size()));
+  if (!file) {
+    throw std::runtime_error("Cannot write file: " + index_filename);
+  }
+}
+
+/**
+ * Reads a line index from a sidecar file written by save_line_index.
+ *
+ * @param index_filename Path to the sidecar file
+ * @param index Receives the index on success
+ * @return bool false if the sidecar file is missing, truncated, inconsistent or of another version
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+bool load_line_index(const std::string &index_filename, LineIndex &index)
+{
+  std::ifstream file(index_filename, std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+  std::string in((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  if (in.size() < sizeof(LINE_INDEX_MAGIC) || std::memcmp(in.data(), LINE_INDEX_MAGIC, sizeof(LINE_INDEX_MAGIC)) != 0) {
+    return false;
+  }
+
+  size_t pos = sizeof(LINE_INDEX_MAGIC);
+  uint64_t version, mtime, nb_offsets;
+  LineIndex result;
+  if (!get_u64(in, pos, version) || version != LINE_INDEX_VERSION ||
+      !get_u64(in, pos, result.file_size) ||
+      !get_u64(in, pos, mtime) ||
+      !get_u64(in, pos, result.stride) ||
+      !get_u64(in, pos, result.nb_lines) ||
+      !get_u64(in, pos, result.nb_non_empty_lines) ||
+      !get_u64(in, pos, nb_offsets) ||
+      result.stride == 0 || nb_offsets > in.size() - pos) {
+    return false;
+  }
+  result.file_mtime = static_cast<int64_t>(mtime);
+
+  // One offset per stride lines, increasing and within the file: seek_to_line relies on it
+  const uint64_t nb_expected = result.nb_lines / result.stride + (result.nb_lines % result.stride != 0 ? 1 : 0);
+  if (nb_offsets != nb_expected) {
+    return false;
+  }
+
+  result.offsets.reserve(nb_offsets);
+  uint64_t offset = 0;
+  for (uint64_t i = 0; i < nb_offsets; i++) {
+    uint64_t delta;
+    if (!get_varint(in, pos, delta) || (i > 0 && delta == 0) || delta >= result.file_size - offset) {
+      return false;
+    }
+    offset += delta;
+    result.offsets.push_back(offset);
+  }
+
+  index = std::move(result);
+  return true;
+}
+
+/**
+ * Tells whether a line index still describes a file, i.e. whether the
+ * file has kept the size and last write time it had when it was indexed.
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+bool is_line_index_fresh(const LineIndex &index, const std::string &filename)
+{
+  std::error_code ec;
+  uintmax_t size = std::filesystem::file_size(filename, ec);
+  if (ec || size != index.file_size) {
+    return false;
+  }
+  return !ec && last_write_ticks(filename) == index.file_mtime;
+}
+
+/**
+ * Returns the line index of a file, loading it from the sidecar file
+ * (filename + ".lidx") when it is still fresh and has the requested stride,
+ * and otherwise rebuilding it and refreshing the sidecar file.
+ *
+ * The sidecar file is a cache: failing to write it (e.g. read-only
+ * directory) is not an error.
+ *
+ * @param filename Path to the indexed file
+ * @param stride Number of lines between two recorded offsets
+ * @return LineIndex A fresh index of the file
+ * @throws std::runtime_error if the file cannot be opened
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+LineIndex get_line_index(const std::string &filename, uint64_t stride)
+{
+  const std::string index_filename = filename + ".lidx";
+
+  LineIndex index;
+  if (load_line_index(index_filename, index) && index.stride == stride && is_line_index_fresh(index, filename)) {
+    return index;
+  }
+
+  index = build_line_index(filename, stride);
+  try {
+    save_line_index(index, index_filename);
+  } catch (const std::runtime_error &) {
+    // cache only
+  }
+  return index;
+}
+
+/**
+ * Returns the byte offset at which a line starts, using one index lookup
+ * followed by a scan of at most (stride - 1) lines.
+ *
+ * @param index Line index of the file (see get_line_index)
+ * @param filename Path to the indexed file
+ * @param line Line number, from 0
+ * @return uint64_t Byte offset of the first character of the line
+ * @throws std::out_of_range if line >= index.nb_lines
+ * @throws std::runtime_error if the file cannot be opened
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+uint64_t line_offset(const LineIndex &index, const std::string &filename, uint64_t line)
+{
+  std::ifstream file;
+  seek_to_line(file, index, filename, line);
+  return static_cast<uint64_t>(file.tellg());
+}
+
+/**
+ * Reads lines [first, last) of a file, using its line index to start
+ * reading close to the first requested line.
+ *
+ * Lines are returned without their trailing '\n' (as with std::getline).
+ * A range extending beyond the end of the file is truncated.
+ *
+ * @param index Line index of the file (see get_line_index)
+ * @param filename Path to the indexed file
+ * @param first First line to read, from 0
+ * @param last One past the last line to read
+ * @return std::vector<std::string> The lines read
+ * @throws std::runtime_error if the file cannot be opened
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+std::vector<std::string> read_lines(const LineIndex &index, const std::string &filename, uint64_t first, uint64_t last)
+{
+  std::vector<std::string> lines;
+  if (last > index.nb_lines) {
+    last = index.nb_lines;
+  }
+  if (first >= last) {
+    return lines;
+  }
+
+  std::ifstream file;
+  seek_to_line(file, index, filename, first);
+
+  lines.reserve(last - first);
+  std::string line;
+  for (uint64_t i = first; i < last && std::getline(file, line); i++) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+int SHOW_line_index(void)
+{
+  const std::string filename = "./src/main.cpp";
+
+  LineIndex index = build_line_index(filename, 16);
+  std::cout << filename << ": " << index.nb_lines << " lines, " << index.offsets.size()
+            << " recorded offsets (one every " << index.stride << " lines)" << std::endl;
+
+  for (const std::string &line : read_lines(index, filename, 18, 21)) {
+    std::cout << "  | " << line << std::endl;
+  }
+
+  return 0;
+}
+
+// end
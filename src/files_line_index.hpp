@@ -0,0 +1,27 @@
+#ifndef FILES_LINE_INDEX_HPP
+#define FILES_LINE_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct LineIndex {
+  uint64_t file_size = 0;
+  int64_t file_mtime = 0;          // last write time of the indexed file (clock ticks)
+  uint64_t stride = 0;             // one offset is recorded every `stride` lines
+  uint64_t nb_lines = 0;           // physical lines, empty lines included
+  uint64_t nb_non_empty_lines = 0; // same as count_lines(filename, false)
+  std::vector<uint64_t> offsets;   // offsets[i] = byte offset of line i * stride
+};
+
+LineIndex build_line_index(const std::string &filename, uint64_t stride);
+void save_line_index(const LineIndex &index, const std::string &index_filename);
+bool load_line_index(const std::string &index_filename, LineIndex &index);
+bool is_line_index_fresh(const LineIndex &index, const std::string &filename);
+LineIndex get_line_index(const std::string &filename, uint64_t stride);
+uint64_t line_offset(const LineIndex &index, const std::string &filename, uint64_t line);
+std::vector<std::string> read_lines(const LineIndex &index, const std::string &filename, uint64_t first, uint64_t last);
+int SHOW_line_index(void);
+
+#endif // FILES_LINE_INDEX_HPP
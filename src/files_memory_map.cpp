@@ -0,0 +1,191 @@
+#include "files_memory_map.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Maps a whole file read-only into memory.
+ *
+ * Pages are loaded on first access, so only the parts of the file that are
+ * actually touched are read (e.g. O(log n) pages for a binary search).
+ * An empty file gives an empty view.
+ *
+ * @param filename Path to the file
+ * @throws std::runtime_error if the file cannot be opened or mapped
+ *
+ * Example:
+ *   MemoryMappedFile file("data.csv");
+ *   std::string_view text = file.view();
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+MemoryMappedFile::MemoryMappedFile(const std::string &filename)
+{
+#if defined(_WIN32)
+  HANDLE file = ::CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+  LARGE_INTEGER file_size;
+  if (!::GetFileSizeEx(file, &file_size)) {
+    ::CloseHandle(file);
+    throw std::runtime_error("Cannot stat file: " + filename);
+  }
+  file_handle = file;
+  length = static_cast<size_t>(file_size.QuadPart);
+  if (length > 0) {
+    HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void *view = (mapping == nullptr) ? nullptr : ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+      if (mapping != nullptr) {
+        ::CloseHandle(mapping);
+      }
+      ::CloseHandle(file);
+      throw std::runtime_error("Cannot map file: " + filename);
+    }
+    mapping_handle = mapping;
+    mapped = static_cast<const char *>(view);
+  }
+#else
+  fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Cannot stat file: " + filename);
+  }
+  length = static_cast<size_t>(st.st_size);
+  if (length > 0) {
+    void *p = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Cannot map file: " + filename);
+    }
+    mapped = static_cast<const char *>(p);
+  }
+#endif
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+#if defined(_WIN32)
+  if (mapped != nullptr) {
+    ::UnmapViewOfFile(mapped);
+    ::CloseHandle(mapping_handle);
+  }
+  ::CloseHandle(file_handle);
+#else
+  if (mapped != nullptr) {
+    ::munmap(const_cast<char *>(mapped), length);
+  }
+  ::close(fd);
+#endif
+}
+
+/**
+ * Tells the kernel how the mapping will be accessed (madvise): RANDOM
+ * disables read-ahead, which suits binary searches; SEQUENTIAL increases it.
+ * No-op on Windows.
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+void MemoryMappedFile::advise(AccessPattern pattern) const
+{
+#if !defined(_WIN32)
+  if (mapped == nullptr) {
+    return;
+  }
+  int advice = MADV_NORMAL;
+  if (pattern == AccessPattern::SEQUENTIAL) {
+    advice = MADV_SEQUENTIAL;
+  } else if (pattern == AccessPattern::RANDOM) {
+    advice = MADV_RANDOM;
+  }
+  ::madvise(const_cast<char *>(mapped), length, advice);
+#else
+  (void)pattern;
+#endif
+}
+
+#if !defined(_WIN32)
+namespace {
+
+size_t page_size()
+{
+  static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  return page;
+}
+
+// madvise on the whole pages of [from, to) of a mapping of `length` bytes
+void advise_range(const char *mapped, size_t length, size_t from, size_t to, int advice)
+{
+  from = from / page_size() * page_size();
+  to = std::min(to, length);
+  if (mapped != nullptr && to > from) {
+    ::madvise(const_cast<char *>(mapped) + from, to - from, advice);
+  }
+}
+
+} // namespace
+#endif
+
+/**
+ * Starts reading the pages of [from, to) in the background (madvise
+ * WILLNEED), e.g. the next window while the current one is processed.
+ * No-op on Windows.
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+void MemoryMappedFile::read_ahead(size_t from, size_t to) const
+{
+#if !defined(_WIN32)
+  advise_range(mapped, length, from, to, MADV_WILLNEED);
+#else
+  (void)from;
+  (void)to;
+#endif
+}
+
+/**
+ * Releases the pages of [from, to) from the process (madvise DONTNEED),
+ * so that a file can be scanned with bounded resident memory; the page
+ * holding `to` is kept, except at end of file. With drop_page_cache, the
+ * kernel is also asked to drop them from the page cache. Reading them
+ * again maps them back. No-op on Windows.
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+void MemoryMappedFile::release(size_t from, size_t to, bool drop_page_cache) const
+{
+#if !defined(_WIN32)
+  if (to < length) {
+    to = to / page_size() * page_size();
+  }
+  advise_range(mapped, length, from, to, MADV_DONTNEED);
+#if defined(POSIX_FADV_DONTNEED)
+  if (drop_page_cache && mapped != nullptr && to > from) {
+    ::posix_fadvise(fd, static_cast<off_t>(from), static_cast<off_t>(to - from), POSIX_FADV_DONTNEED);
+  }
+#else
+  (void)drop_page_cache;
+#endif
+#else
+  (void)from;
+  (void)to;
+  (void)drop_page_cache;
+#endif
+}
+
+// end
@@ -0,0 +1,38 @@
+#ifndef FILES_MEMORY_MAP_HPP
+#define FILES_MEMORY_MAP_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+enum class AccessPattern { NORMAL, SEQUENTIAL, RANDOM };
+
+// Read-only memory mapping of a whole file (mmap on POSIX, MapViewOfFile on Windows)
+class MemoryMappedFile {
+public:
+  explicit MemoryMappedFile(const std::string &filename);
+  ~MemoryMappedFile();
+
+  MemoryMappedFile(const MemoryMappedFile &) = delete;
+  MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+  const char *data() const { return mapped; }
+  size_t size() const { return length; }
+  std::string_view view() const { return std::string_view(mapped, length); }
+
+  void advise(AccessPattern pattern) const;
+  void read_ahead(size_t from, size_t to) const;
+  void release(size_t from, size_t to, bool drop_page_cache = false) const;
+
+private:
+  const char *mapped = nullptr;
+  size_t length = 0;
+#if defined(_WIN32)
+  void *file_handle = nullptr;
+  void *mapping_handle = nullptr;
+#else
+  int fd = -1;
+#endif
+};
+
+#endif // FILES_MEMORY_MAP_HPP
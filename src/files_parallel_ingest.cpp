@@ -0,0 +1,346 @@
+#include "files_parallel_ingest.hpp"
+#include "doubles.hpp"
+#include "files.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct IngestTask {
+  size_t file_index;
+  uint64_t start; // the task owns the lines starting in [start, end)
+  uint64_t end;
+};
+
+struct TaskOutcome {
+  size_t nb_lines = 0;
+  std::string error;
+};
+
+size_t count_non_empty_lines(const char *begin, const char *end)
+{
+  size_t count = 0;
+  const char *p = begin;
+  while (p < end) {
+    const char *newline = static_cast<const char *>(std::memchr(p, '\n', end - p));
+    const char *line_end = (newline == nullptr) ? end : newline;
+    if (line_end > p) {
+      count++;
+    }
+    p = line_end + 1;
+  }
+  return count;
+}
+
+// Reads the lines starting in [task.start, task.end), completing the last one
+// beyond task.end if needed, and hands them to the chunk processor.
+size_t process_task(const std::string &filename, uint64_t file_size, size_t file_index, const IngestTask &task,
+                    const ChunkProcessor &on_chunk, std::vector<char> &buffer)
+{
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+
+  // One byte before the range tells whether a line starts exactly at task.start
+  const uint64_t read_start = (task.start > 0) ? task.start - 1 : 0;
+  const size_t length = static_cast<size_t>(task.end - read_start);
+  buffer.resize(length);
+  file.seekg(static_cast<std::streamoff>(read_start));
+  file.read(buffer.data(), static_cast<std::streamsize>(length));
+  if (static_cast<size_t>(file.gcount()) != length) {
+    throw std::runtime_error("Cannot read file: " + filename);
+  }
+
+  size_t first = 0;
+  if (task.start > 0) {
+    const char *newline = static_cast<const char *>(std::memchr(buffer.data(), '\n', length - 1));
+    if (newline == nullptr) {
+      return 0; // a single line spans the whole range and belongs to a previous task
+    }
+    first = static_cast<size_t>(newline - buffer.data()) + 1;
+  }
+
+  if (task.end < file_size && buffer.back() != '\n') {
+    uint64_t position = task.end;
+    while (position < file_size) {
+      size_t step = static_cast<size_t>(std::min<uint64_t>(1 << 16, file_size - position));
+      size_t old_size = buffer.size();
+      buffer.resize(old_size + step);
+      file.read(buffer.data() + old_size, static_cast<std::streamsize>(step));
+      if (static_cast<size_t>(file.gcount()) != step) {
+        throw std::runtime_error("Cannot read file: " + filename);
+      }
+      position += step;
+      const char *newline = static_cast<const char *>(std::memchr(buffer.data() + old_size, '\n', step));
+      if (newline != nullptr) {
+        buffer.resize(static_cast<size_t>(newline - buffer.data()) + 1);
+        break;
+      }
+    }
+  }
+
+  const char *begin = buffer.data() + first;
+  const char *end = buffer.data() + buffer.size();
+  on_chunk(file_index, read_start + first, begin, end);
+  return count_non_empty_lines(begin, end);
+}
+
+struct WorkerQueue {
+  std::mutex mutex;
+  std::deque<size_t> tasks;
+};
+
+// Runs all tasks on a work-stealing pool. Each worker takes its own tasks
+// from the front (largest first); idle workers steal from the back of the
+// other queues (smallest first), which evens out the tail.
+template <typename Fn>
+void run_work_stealing(const std::vector<IngestTask> &tasks, int nb_threads, const Fn &fn)
+{
+  std::vector<size_t> order(tasks.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return tasks[a].end - tasks[a].start > tasks[b].end - tasks[b].start;
+  });
+
+  std::vector<WorkerQueue> queues(nb_threads);
+  for (size_t i = 0; i < order.size(); i++) {
+    queues[i % nb_threads].tasks.push_back(order[i]);
+  }
+
+  auto worker = [&](int w) {
+    while (true) {
+      size_t task_id = 0;
+      bool found = false;
+      {
+        std::lock_guard<std::mutex> lock(queues[w].mutex);
+        if (!queues[w].tasks.empty()) {
+          task_id = queues[w].tasks.front();
+          queues[w].tasks.pop_front();
+          found = true;
+        }
+      }
+      for (int k = 1; k < nb_threads && !found; k++) {
+        WorkerQueue &victim = queues[(w + k) % nb_threads];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+          task_id = victim.tasks.back();
+          victim.tasks.pop_back();
+          found = true;
+        }
+      }
+      if (!found) {
+        return; // no task is ever added, so all queues are empty for good
+      }
+      fn(task_id);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(nb_threads - 1);
+  for (int w = 1; w < nb_threads; w++) {
+    threads.emplace_back(worker, w);
+  }
+  worker(0);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+} // namespace
+
+/**
+ * Ingests many files in parallel, balancing the work across threads even
+ * when file sizes vary by orders of magnitude.
+ *
+ * Small files are processed whole; files larger than options.chunk_size
+ * are split into byte ranges that are realigned on line boundaries, so
+ * that every line is handed exactly once, in one piece, to on_chunk.
+ * Tasks are scheduled on a work-stealing pool, largest first, so that a
+ * single huge file does not leave the other threads idle at the end.
+ *
+ * on_chunk is called concurrently from several threads and must be
+ * thread-safe. Its exceptions are reported in the result of the file
+ * instead of being propagated.
+ *
+ * @param filenames Files to ingest
+ * @param on_chunk Callback receiving (file index, offset, begin, end) for each chunk of whole lines
+ * @param options Number of threads and chunk size
+ * @return std::vector<IngestResult> Per-file results (bytes, non-empty lines, chunks, error), in input order
+ *
+ * Example:
+ *   auto results = ingest_files(filenames, [&](size_t i, uint64_t, const char *begin, const char *end) {
+ *     parse_rows(i, begin, end);
+ *   });
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+std::vector<IngestResult> ingest_files(const std::vector<std::string> &filenames, const ChunkProcessor &on_chunk, const IngestOptions &options)
+{
+  const uint64_t chunk_size = std::max<uint64_t>(options.chunk_size, 1);
+
+  std::vector<IngestResult> results(filenames.size());
+  std::vector<IngestTask> tasks;
+  for (size_t i = 0; i < filenames.size(); i++) {
+    results[i].filename = filenames[i];
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(filenames[i], ec);
+    if (ec) {
+      results[i].error = "Cannot open file: " + filenames[i];
+      continue;
+    }
+    results[i].bytes = size;
+    for (uint64_t start = 0; start < size; start += chunk_size) {
+      tasks.push_back({i, start, std::min<uint64_t>(start + chunk_size, size)});
+      results[i].nb_chunks++;
+    }
+  }
+
+  int nb_threads = options.nb_threads > 0 ? options.nb_threads : static_cast<int>(std::thread::hardware_concurrency());
+  nb_threads = std::max(1, std::min<int>(nb_threads, static_cast<int>(tasks.size())));
+
+  std::vector<TaskOutcome> outcomes(tasks.size());
+  run_work_stealing(tasks, nb_threads, [&](size_t task_id) {
+    thread_local std::vector<char> buffer;
+    const IngestTask &task = tasks[task_id];
+    try {
+      outcomes[task_id].nb_lines = process_task(filenames[task.file_index], results[task.file_index].bytes,
+                                                task.file_index, task, on_chunk, buffer);
+    } catch (const std::exception &e) {
+      outcomes[task_id].error = e.what();
+    }
+  });
+
+  for (size_t t = 0; t < tasks.size(); t++) {
+    IngestResult &result = results[tasks[t].file_index];
+    result.nb_lines += outcomes[t].nb_lines;
+    if (result.error.empty()) {
+      result.error = outcomes[t].error;
+    }
+  }
+  return results;
+}
+
+/**
+ * Ingests all regular files of a directory (optionally filtered by
+ * extension, in name order) with ingest_files.
+ *
+ * @throws std::runtime_error if the directory cannot be listed
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+std::vector<IngestResult> ingest_directory(const std::string &directory, const ChunkProcessor &on_chunk, const IngestOptions &options)
+{
+  std::vector<std::string> filenames;
+  std::error_code ec;
+  for (const auto &entry : std::filesystem::directory_iterator(directory, ec)) {
+    if (entry.is_regular_file() && (options.extension.empty() || entry.path().extension() == options.extension)) {
+      filenames.push_back(entry.path().string());
+    }
+  }
+  if (ec) {
+    throw std::runtime_error("Cannot open directory: " + directory);
+  }
+  std::sort(filenames.begin(), filenames.end());
+  return ingest_files(filenames, on_chunk, options);
+}
+
+int SHOW_ingest_directory(void)
+{
+  namespace fs = std::filesystem;
+  const fs::path directory = fs::temp_directory_path() / "cpp_utils_ingest";
+  fs::remove_all(directory);
+  fs::create_directories(directory);
+
+  // 64 per-symbol files whose sizes vary 1000x, plus one very large file
+  for (int i = 0; i <= 64; i++) {
+    int nb_rows = (i == 64) ? 200'000 : 20 << (i % 11);
+    std::ofstream out(directory / ("symbol_" + std::to_string(i) + ".csv"));
+    out << "Gmt time;Open;High;Low;Close;Volume\n";
+    for (int r = 0; r < nb_rows; r++) {
+      out << "01.02.2013 00:00:00.000;1,36115;1,36125;1,36110;1,3612" << (r % 10) << ";12,5\n";
+    }
+  }
+
+  // Parses the close price of each row (skipping the header)
+  auto parse_closes = [](const char *begin, const char *end) {
+    double sum = 0.0;
+    const char *p = begin;
+    while (p < end) {
+      const char *newline = static_cast<const char *>(std::memchr(p, '\n', end - p));
+      const char *line_end = (newline == nullptr) ? end : newline;
+      std::string line(p, line_end);
+      if (!line.empty() && line[0] != 'G') {
+        size_t last = line.rfind(';');
+        size_t close = line.rfind(';', last - 1);
+        sum += parse_double(line.substr(close + 1, last - close - 1), ',');
+      }
+      p = line_end + 1;
+    }
+    return sum;
+  };
+
+  std::vector<std::string> filenames;
+  for (const auto &entry : fs::directory_iterator(directory)) {
+    filenames.push_back(entry.path().string());
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  size_t naive_lines = 0;
+  double naive_sum = 0.0;
+  for (const std::string &filename : filenames) {
+    naive_lines += count_lines(filename, false);
+    std::ifstream file(filename);
+    std::string line;
+    while (std::getline(file, line)) {
+      line += '\n';
+      naive_sum += parse_closes(line.data(), line.data() + line.size());
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> naive_duration = end - start;
+
+  start = std::chrono::steady_clock::now();
+  std::mutex sum_mutex;
+  double pool_sum = 0.0;
+  auto results = ingest_directory(directory.string(), [&](size_t, uint64_t, const char *begin, const char *end) {
+    double sum = parse_closes(begin, end);
+    std::lock_guard<std::mutex> lock(sum_mutex);
+    pool_sum += sum;
+  });
+  end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> pool_duration = end - start;
+
+  size_t pool_lines = 0;
+  size_t pool_chunks = 0;
+  for (const IngestResult &result : results) {
+    pool_lines += result.nb_lines;
+    pool_chunks += result.nb_chunks;
+  }
+
+  std::cout << "Naive loop:       " << filenames.size() << " files, " << naive_lines << " lines, sum = " << naive_sum
+            << " (in " << naive_duration.count() << " s)" << std::endl;
+  std::cout << "ingest_directory: " << results.size() << " files, " << pool_lines << " lines, sum = " << pool_sum
+            << " (in " << pool_duration.count() << " s, " << pool_chunks << " tasks, "
+            << std::thread::hardware_concurrency() << " threads)" << std::endl;
+  std::cout << "=> makespan speedup: " << naive_duration.count() / pool_duration.count() << std::endl;
+
+  fs::remove_all(directory);
+  return 0;
+}
+
+// end
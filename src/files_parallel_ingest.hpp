@@ -0,0 +1,33 @@
+#ifndef FILES_PARALLEL_INGEST_HPP
+#define FILES_PARALLEL_INGEST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct IngestOptions {
+  int nb_threads = 0;            // 0 = std::thread::hardware_concurrency()
+  uint64_t chunk_size = 4 << 20; // larger files are split into line-aligned chunks of about this size
+  std::string extension;         // e.g. ".csv" (ingest_directory only); empty = all regular files
+};
+
+struct IngestResult {
+  std::string filename;
+  uint64_t bytes = 0;
+  size_t nb_lines = 0;  // non-empty lines, as count_lines(filename, false)
+  size_t nb_chunks = 0; // number of tasks the file was split into
+  std::string error;    // empty on success
+};
+
+// Called concurrently from the worker threads, once per chunk of whole lines
+using ChunkProcessor = std::function<void(size_t file_index, uint64_t offset, const char *begin, const char *end)>;
+
+std::vector<IngestResult> ingest_files(const std::vector<std::string> &filenames, const ChunkProcessor &on_chunk,
+                                       const IngestOptions &options = IngestOptions());
+std::vector<IngestResult> ingest_directory(const std::string &directory, const ChunkProcessor &on_chunk,
+                                           const IngestOptions &options = IngestOptions());
+int SHOW_ingest_directory(void);
+
+#endif // FILES_PARALLEL_INGEST_HPP
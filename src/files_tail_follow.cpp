@@ -0,0 +1,293 @@
+#include "files_tail_follow.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#endif
+
+/**
+ * Follows a file that keeps growing (like `tail -f`) and delivers only the
+ * complete lines appended since the previous call, without rescanning.
+ *
+ * The follower remembers the byte offset already consumed and the partial
+ * trailing line (bytes not yet terminated by '\n'), which is completed by
+ * the next append. Empty lines are skipped, as in count_lines.
+ *
+ * On Linux, wait_and_poll sleeps on an inotify watch and wakes up as soon
+ * as the file is modified (append-to-delivery latency is typically a few
+ * tens of microseconds). Elsewhere, or if inotify is not available, the
+ * file size is polled every poll_interval.
+ *
+ * If the file shrinks (truncation or rewrite), reading restarts from the
+ * beginning of the file.
+ *
+ * @param filename Path to the followed file
+ * @param from_end If true, existing content is skipped and only lines appended later are delivered
+ * @param poll_interval Polling period when inotify is not available
+ * @throws std::runtime_error if the file cannot be opened
+ *
+ * Example:
+ *   TailFollower follower("feed.csv", true);
+ *   while (running) {
+ *     follower.wait_and_poll([](std::string_view row) { process(row); }, std::chrono::milliseconds(100));
+ *   }
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+TailFollower::TailFollower(const std::string &filename, bool from_end, std::chrono::microseconds poll_interval)
+    : filename(filename), poll_interval(poll_interval)
+{
+#if defined(_WIN32)
+  fd = _open(filename.c_str(), _O_RDONLY | _O_BINARY);
+#else
+  fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+
+#if defined(__linux__)
+  inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd >= 0 && ::inotify_add_watch(inotify_fd, filename.c_str(), IN_MODIFY | IN_ATTRIB) < 0) {
+    ::close(inotify_fd);
+    inotify_fd = -1; // polling fallback
+  }
+#endif
+
+  buffer.resize(1 << 16);
+
+  if (from_end) {
+    read_offset = current_size();
+    if (read_offset > 0) {
+      // If the file ends in the middle of a line, the rest of that line must not be delivered
+      char last = '\n';
+#if defined(_WIN32)
+      _lseeki64(fd, static_cast<long long>(read_offset - 1), SEEK_SET);
+      bool ok = _read(fd, &last, 1) == 1;
+#else
+      bool ok = ::pread(fd, &last, 1, static_cast<off_t>(read_offset - 1)) == 1;
+#endif
+      discard_partial = ok && last != '\n';
+    }
+  }
+}
+
+TailFollower::~TailFollower()
+{
+#if defined(_WIN32)
+  _close(fd);
+#else
+  ::close(fd);
+  if (inotify_fd >= 0) {
+    ::close(inotify_fd);
+  }
+#endif
+}
+
+uint64_t TailFollower::current_size() const
+{
+#if defined(_WIN32)
+  struct _stat64 st;
+  if (_fstat64(fd, &st) != 0) {
+#else
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+#endif
+    throw std::runtime_error("Cannot stat file: " + filename);
+  }
+  return static_cast<uint64_t>(st.st_size);
+}
+
+/**
+ * Reads the bytes appended since the previous call and delivers the newly
+ * completed, non-empty lines (without their '\n'). Does not block.
+ *
+ * The string_view passed to the callback is only valid during the call.
+ *
+ * @param on_line Callback receiving each new line
+ * @return size_t Number of lines delivered
+ * @throws std::runtime_error if the file cannot be read
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+size_t TailFollower::poll(const LineCallback &on_line)
+{
+  uint64_t size = current_size();
+  if (size < read_offset) {
+    read_offset = 0; // truncated or rewritten: start over
+    partial.clear();
+    discard_partial = false;
+  }
+
+  size_t nb_lines = 0;
+  while (read_offset < size) {
+    size_t length = static_cast<size_t>(std::min<uint64_t>(buffer.size(), size - read_offset));
+#if defined(_WIN32)
+    _lseeki64(fd, static_cast<long long>(read_offset), SEEK_SET);
+    long long n = _read(fd, buffer.data(), static_cast<unsigned>(length));
+#else
+    long long n = ::pread(fd, buffer.data(), length, static_cast<off_t>(read_offset));
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+#endif
+    if (n < 0) {
+      throw std::runtime_error("Cannot read file: " + filename);
+    }
+    if (n == 0) {
+      break;
+    }
+    read_offset += static_cast<uint64_t>(n);
+
+    const char *p = buffer.data();
+    const char *end = p + n;
+    while (p < end) {
+      const char *newline = static_cast<const char *>(std::memchr(p, '\n', end - p));
+      if (newline == nullptr) {
+        partial.append(p, end - p);
+        break;
+      }
+
+      std::string_view line;
+      if (partial.empty()) {
+        line = std::string_view(p, newline - p);
+      } else {
+        partial.append(p, newline - p);
+        line = partial;
+      }
+
+      if (discard_partial) {
+        discard_partial = false;
+      } else if (!line.empty()) {
+        on_line(line);
+        nb_lines++;
+      }
+      partial.clear();
+      p = newline + 1;
+    }
+  }
+  return nb_lines;
+}
+
+/**
+ * Delivers the new complete lines, waiting for the file to grow if there
+ * are none yet.
+ *
+ * @param on_line Callback receiving each new line
+ * @param timeout Maximum waiting time
+ * @return size_t Number of lines delivered (0 if the timeout expired)
+ * @throws std::runtime_error if the file cannot be read
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+size_t TailFollower::wait_and_poll(const LineCallback &on_line, std::chrono::milliseconds timeout)
+{
+  size_t nb_lines = poll(on_line);
+  if (nb_lines > 0) {
+    return nb_lines;
+  }
+
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (true) {
+    auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+      return 0;
+    }
+
+#if defined(__linux__)
+    if (inotify_fd >= 0) {
+      auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count() + 1;
+      pollfd pfd{inotify_fd, POLLIN, 0};
+      if (::poll(&pfd, 1, static_cast<int>(remaining)) > 0) {
+        char events[4096];
+        while (::read(inotify_fd, events, sizeof(events)) > 0) {
+          // drain pending events
+        }
+      }
+    } else
+#endif
+    {
+      std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(poll_interval, deadline - now));
+    }
+
+    nb_lines = poll(on_line);
+    if (nb_lines > 0) {
+      return nb_lines;
+    }
+  }
+}
+
+int SHOW_tail_follow(void)
+{
+  const std::string filename = (std::filesystem::temp_directory_path() / "cpp_utils_tail_follow.csv").string();
+  {
+    std::ofstream out(filename, std::ios::trunc);
+    out << "Gmt time;Close\n";
+  }
+
+  TailFollower follower(filename, true);
+  std::cout << "Following " << filename << (follower.uses_inotify() ? " with inotify" : " by polling") << std::endl;
+
+  const int nb_rows = 100;
+  std::atomic<long long> written_at_ns{0};
+
+  std::thread writer([&]() {
+    std::FILE *out = std::fopen(filename.c_str(), "ab");
+    for (int i = 0; i < nb_rows; i++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      written_at_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+      std::fprintf(out, "01.02.2013 00:00:%02d.000;1,3612%d\n", i % 60, i % 10);
+      std::fflush(out);
+    }
+    std::fclose(out);
+  });
+
+  std::vector<double> latencies_us;
+  while (static_cast<int>(latencies_us.size()) < nb_rows) {
+    size_t n = follower.wait_and_poll([&](std::string_view) {
+      long long now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+      latencies_us.push_back((now_ns - written_at_ns) / 1000.0);
+    }, std::chrono::milliseconds(1000));
+    if (n == 0) {
+      break;
+    }
+  }
+  writer.join();
+  std::filesystem::remove(filename);
+
+  if (latencies_us.empty()) {
+    std::cout << "No row received." << std::endl;
+    return 1;
+  }
+
+  std::sort(latencies_us.begin(), latencies_us.end());
+  std::cout << latencies_us.size() << " rows received, append-to-delivery latency: median "
+            << latencies_us[latencies_us.size() / 2] << " us, max " << latencies_us.back() << " us" << std::endl;
+  return 0;
+}
+
+// end
@@ -0,0 +1,43 @@
+#ifndef FILES_TAIL_FOLLOW_HPP
+#define FILES_TAIL_FOLLOW_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+using LineCallback = std::function<void(std::string_view line)>;
+
+class TailFollower {
+public:
+  explicit TailFollower(const std::string &filename, bool from_end = false,
+                        std::chrono::microseconds poll_interval = std::chrono::microseconds(200));
+  ~TailFollower();
+
+  TailFollower(const TailFollower &) = delete;
+  TailFollower &operator=(const TailFollower &) = delete;
+
+  size_t poll(const LineCallback &on_line);
+  size_t wait_and_poll(const LineCallback &on_line, std::chrono::milliseconds timeout);
+
+  uint64_t offset() const { return read_offset; }
+  bool uses_inotify() const { return inotify_fd >= 0; }
+
+private:
+  uint64_t current_size() const;
+
+  std::string filename;
+  std::chrono::microseconds poll_interval;
+  int fd = -1;
+  int inotify_fd = -1;
+  uint64_t read_offset = 0;     // bytes consumed so far (including the partial line)
+  std::string partial;          // trailing bytes not yet terminated by '\n'
+  bool discard_partial = false; // started in the middle of a line (from_end)
+  std::string buffer;
+};
+
+int SHOW_tail_follow(void);
+
+#endif // FILES_TAIL_FOLLOW_HPP
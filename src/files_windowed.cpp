@@ -0,0 +1,233 @@
+#include "files_windowed.hpp"
+#include "doubles.hpp"
+#include "files.hpp"
+#include "files_memory_map.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+namespace {
+
+// End of the window starting at `start`: after the last '\n' before `limit`, or `size`
+size_t window_end(const char *data, size_t start, size_t limit, size_t size, const std::string &filename)
+{
+  if (limit >= size) {
+    return size;
+  }
+  size_t newline = std::string_view(data + start, limit - start).rfind('\n');
+  if (newline == std::string_view::npos) {
+    throw std::runtime_error("Line longer than the window in file: " + filename);
+  }
+  return start + newline + 1;
+}
+
+// Resident set size of the process, in bytes (0 if unknown)
+size_t resident_bytes()
+{
+#if defined(__linux__)
+  std::ifstream statm("/proc/self/statm");
+  size_t total_pages = 0;
+  size_t resident_pages = 0;
+  statm >> total_pages >> resident_pages;
+  return resident_pages * static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+#else
+  return 0;
+#endif
+}
+
+} // namespace
+
+/**
+ * Processes a file of any size, window by window, with bounded memory.
+ *
+ * Each window holds whole lines (the last one may lack its '\n' at end of
+ * file). The file is memory-mapped; while the callback processes a
+ * window, the next one is read ahead (madvise WILLNEED), and once
+ * processed, the window is released (madvise DONTNEED), so that at most
+ * memory_budget bytes of the file are resident in the process. Windows
+ * are memory_budget / 2 bytes; a line must fit in a window.
+ *
+ * On Windows, windows are read into a buffer of memory_budget / 2 bytes.
+ *
+ * @param filename Path to the file
+ * @param on_window Callback receiving [begin, end) and the file offset of begin
+ * @param options Memory budget and page cache policy
+ * @return size_t Number of windows processed
+ * @throws std::runtime_error if the file cannot be opened or mapped, or if a line is longer than a window
+ * @throws std::invalid_argument if the memory budget is less than two pages
+ *
+ * Example:
+ *   process_file_in_windows("ticks.csv", [&](const char *b, const char *e, uint64_t) { n += std::count(b, e, '\n'); })
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+size_t process_file_in_windows(const std::string &filename, const WindowCallback &on_window, const WindowOptions &options)
+{
+  const size_t window_size = options.memory_budget / 2 / 4096 * 4096;
+  if (window_size == 0) {
+    throw std::invalid_argument("Memory budget must be at least 8 KB");
+  }
+
+  size_t nb_windows = 0;
+#if defined(_WIN32)
+  std::FILE *file = std::fopen(filename.c_str(), "rb");
+  if (file == nullptr) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+  std::vector<char> buffer(window_size);
+  size_t used = 0;
+  uint64_t offset = 0;
+  try {
+    while (true) {
+      used += std::fread(buffer.data() + used, 1, buffer.size() - used, file);
+      bool at_eof = used < buffer.size();
+      if (used == 0) {
+        break;
+      }
+      size_t end = at_eof ? used : window_end(buffer.data(), 0, used, used + 1, filename);
+      on_window(buffer.data(), buffer.data() + end, offset);
+      nb_windows++;
+      offset += end;
+      std::memmove(buffer.data(), buffer.data() + end, used - end);
+      used -= end;
+      if (at_eof && used == 0) {
+        break;
+      }
+    }
+  } catch (...) {
+    std::fclose(file);
+    throw;
+  }
+  std::fclose(file);
+#else
+  MemoryMappedFile mapping(filename);
+  const size_t size = mapping.size();
+  size_t start = 0;
+  if (size > 0) {
+    mapping.read_ahead(0, window_size);
+  }
+  while (start < size) {
+    size_t end = window_end(mapping.data(), start, start + window_size, size, filename);
+    mapping.read_ahead(end, end + window_size);
+    on_window(mapping.data() + start, mapping.data() + end, start);
+    nb_windows++;
+    mapping.release(start, end, options.drop_page_cache);
+    start = end;
+  }
+  mapping.release(0, size, options.drop_page_cache);
+#endif
+  return nb_windows;
+}
+
+/**
+ * Counts the non-empty lines of a file, as count_lines, with memory bounded
+ * by options.memory_budget.
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+size_t count_lines_windowed(const std::string &filename, bool skipHeader, const WindowOptions &options)
+{
+  // A line is non-empty if it has a character other than '\n' (as std::getline, '\r' counts)
+  struct State {
+    size_t count = 0;
+    bool line_started = false;
+  };
+  State state = reduce_file_in_windows(
+      filename, State(),
+      [](State s, const char *begin, const char *end) {
+        for (const char *p = begin; p < end;) {
+          const char *newline = static_cast<const char *>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+          if (newline == nullptr) {
+            s.line_started = true;
+            break;
+          }
+          if (newline > p) {
+            s.count++;
+          }
+          p = newline + 1;
+        }
+        return s;
+      },
+      options);
+  if (state.line_started) {
+    state.count++; // last line without '\n'
+  }
+  if (skipHeader && state.count > 0) {
+    state.count--;
+  }
+  return state.count;
+}
+
+int SHOW_process_file_in_windows(void)
+{
+  const std::string filename = (std::filesystem::temp_directory_path() / "cpp_utils_windowed.csv").string();
+  {
+    std::ofstream file(filename, std::ios::binary);
+    file << "Gmt time;Close\n";
+    std::string line;
+    for (int i = 0; i < 1'000'000; i++) {
+      line = "01.02.2013 00:00:00.000;1," + std::to_string(36000 + (i % 1000) * 7 % 1000) + "\n";
+      file << line;
+    }
+  }
+
+  WindowOptions options;
+  options.memory_budget = 4 << 20;
+
+  // Reducer: line count, min and max of the close
+  struct Stats {
+    size_t nb_lines = 0;
+    double min = std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::lowest();
+  };
+  const size_t baseline = resident_bytes();
+  size_t peak = baseline;
+  auto start = std::chrono::steady_clock::now();
+  Stats stats = reduce_file_in_windows(
+      filename, Stats(),
+      [&peak](Stats s, const char *begin, const char *end) {
+        for (const char *p = begin; p < end;) {
+          const char *newline = static_cast<const char *>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+          const char *line_end = newline ? newline : end;
+          const char *delimiter = static_cast<const char *>(std::memchr(p, ';', static_cast<size_t>(line_end - p)));
+          if (delimiter != nullptr && delimiter + 1 < line_end && delimiter[1] != 'C') { // skip the header
+            double close = parse_double(std::string(delimiter + 1, line_end), ',');
+            s.min = std::min(s.min, close);
+            s.max = std::max(s.max, close);
+            s.nb_lines++;
+          }
+          p = line_end + 1;
+        }
+        peak = std::max(peak, resident_bytes());
+        return s;
+      },
+      options);
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double> duration = end - start;
+
+  std::cout << "File: " << std::filesystem::file_size(filename) / (1 << 20) << " MB, memory budget: "
+            << options.memory_budget / (1 << 20) << " MB" << std::endl;
+  std::cout << "reduce_file_in_windows: " << stats.nb_lines << " lines, close in [" << stats.min << ", " << stats.max
+            << "] (in " << duration.count() << " s)" << std::endl;
+  std::cout << "Peak resident memory growth during the scan: " << (peak - baseline) / 1024 << " KB" << std::endl;
+  std::cout << "count_lines_windowed: " << count_lines_windowed(filename, true, options)
+            << ", count_lines: " << count_lines(filename, true) << std::endl;
+
+  std::filesystem::remove(filename);
+  return 0;
+}
+
+// end
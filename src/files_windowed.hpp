@@ -0,0 +1,42 @@
+#ifndef FILES_WINDOWED_HPP
+#define FILES_WINDOWED_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+
+struct WindowOptions {
+  size_t memory_budget = 64 << 20; // maximum bytes of the file resident at once (current window + read-ahead)
+  bool drop_page_cache = false;    // also evict processed windows from the page cache (posix_fadvise)
+};
+
+// Called once per window of whole lines, in file order
+using WindowCallback = std::function<void(const char *begin, const char *end, uint64_t offset)>;
+
+size_t process_file_in_windows(const std::string &filename, const WindowCallback &on_window,
+                               const WindowOptions &options = WindowOptions());
+size_t count_lines_windowed(const std::string &filename, bool skipHeader, const WindowOptions &options = WindowOptions());
+int SHOW_process_file_in_windows(void);
+
+/**
+ * Folds a file, window by window, with state = reduce(std::move(state), begin, end).
+ * See process_file_in_windows.
+ *
+ * Example:
+ *   reduce_file_in_windows("ticks.csv", size_t(0), [](size_t n, const char *b, const char *e) { return n + std::count(b, e, '\n'); })
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-18)
+ */
+template <typename State, typename Reducer>
+State reduce_file_in_windows(const std::string &filename, State state, Reducer reduce,
+                             const WindowOptions &options = WindowOptions())
+{
+  process_file_in_windows(
+      filename, [&](const char *begin, const char *end, uint64_t) { state = reduce(std::move(state), begin, end); },
+      options);
+  return state;
+}
+
+#endif // FILES_WINDOWED_HPP
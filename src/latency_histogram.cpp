@@ -0,0 +1,202 @@
+#include "latency_histogram.hpp"
+#include "csv_reader.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+LatencyHistogram::LatencyHistogram(int precision_bits) : bits(precision_bits)
+{
+  if (precision_bits < 1 || precision_bits > 20) {
+    throw std::invalid_argument("Histogram precision out of [1, 20] bits: " + std::to_string(precision_bits));
+  }
+  counts.assign(static_cast<size_t>(65 - bits) << bits, 0);
+}
+
+// Adds the values of another histogram (e.g. of another thread), of the same precision
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+  if (other.bits != bits) {
+    throw std::invalid_argument("Cannot merge histograms of different precisions");
+  }
+  for (size_t i = 0; i < counts.size(); i++) {
+    counts[i] += other.counts[i];
+  }
+  total += other.total;
+  sum += other.sum;
+  min_value = std::min(min_value, other.min_value);
+  max_value = std::max(max_value, other.max_value);
+}
+
+void LatencyHistogram::reset()
+{
+  std::fill(counts.begin(), counts.end(), 0);
+  total = 0;
+  sum = 0.0;
+  min_value = UINT64_MAX;
+  max_value = 0;
+}
+
+uint64_t LatencyHistogram::bucket_lowest_value(size_t index) const
+{
+  const size_t group = index >> bits;
+  const uint64_t sub_bucket = index & ((size_t(1) << bits) - 1);
+  if (group == 0) {
+    return sub_bucket;
+  }
+  return ((uint64_t(1) << bits) + sub_bucket) << (group - 1);
+}
+
+uint64_t LatencyHistogram::bucket_highest_value(size_t index) const
+{
+  const size_t group = index >> bits;
+  return group == 0 ? bucket_lowest_value(index) : bucket_lowest_value(index) + ((uint64_t(1) << (group - 1)) - 1);
+}
+
+/**
+ * Returns the value below or at which p% of the recorded values are:
+ * the highest value of the bucket holding that rank, so that the result
+ * is never below the exact percentile, and within the histogram's
+ * precision of it; clamped to the recorded min and max.
+ *
+ * @param p Percentile, in [0, 100] (e.g. 99.9)
+ * @return uint64_t Value, 0 if nothing was recorded
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+uint64_t LatencyHistogram::percentile(double p) const
+{
+  if (total == 0) {
+    return 0;
+  }
+  p = std::clamp(p, 0.0, 100.0);
+  const uint64_t rank =
+      std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(total))));
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < counts.size(); i++) {
+    cumulative += counts[i];
+    if (cumulative >= rank) {
+      return std::clamp(bucket_highest_value(i), min(), max_value);
+    }
+  }
+  return max_value;
+}
+
+// One line: count, mean and tail percentiles (values in nanoseconds)
+void print_latency_summary(const std::string &name, const LatencyHistogram &histogram, std::ostream &out)
+{
+  auto flags = out.flags();
+  auto precision = out.precision();
+  out << name << ": " << histogram.count() << " values, mean " << std::fixed << std::setprecision(1)
+      << histogram.mean() << " ns, min " << histogram.min() << ", p50 " << histogram.percentile(50.0) << ", p90 "
+      << histogram.percentile(90.0) << ", p99 " << histogram.percentile(99.0) << ", p99.9 "
+      << histogram.percentile(99.9) << ", p99.99 " << histogram.percentile(99.99) << ", max " << histogram.max()
+      << " ns" << std::endl;
+  out.flags(flags);
+  out.precision(precision);
+}
+
+/**
+ * Writes the percentile distribution in the HdrHistogram text format
+ * (.hgrm: value, percentile, total count, 1/(1 - percentile)), one line
+ * per non-empty bucket, to be plotted e.g. with the HdrHistogram plotter.
+ *
+ * @param histogram Histogram
+ * @param out Output stream
+ * @param value_scale Divisor of the values (e.g. 1000 for microseconds from nanoseconds)
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+void write_percentile_distribution(const LatencyHistogram &histogram, std::ostream &out, double value_scale)
+{
+  auto flags = out.flags();
+  auto precision = out.precision();
+  out << std::right << std::setw(12) << "Value" << std::setw(15) << "Percentile" << std::setw(11) << "TotalCount"
+      << std::setw(15) << "1/(1-Percentile)" << "\n\n";
+  out << std::fixed;
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < histogram.bucket_count(); i++) {
+    if (histogram.bucket_count_at(i) == 0) {
+      continue;
+    }
+    cumulative += histogram.bucket_count_at(i);
+    const double value =
+        static_cast<double>(std::min(histogram.bucket_highest_value(i), histogram.max())) / value_scale;
+    const double fraction = static_cast<double>(cumulative) / static_cast<double>(histogram.count());
+    out << std::setprecision(3) << std::setw(12) << value << std::setprecision(12) << std::setw(15) << fraction
+        << std::setw(11) << cumulative;
+    if (cumulative < histogram.count()) {
+      out << std::setprecision(2) << std::setw(15) << 1.0 / (1.0 - fraction);
+    }
+    out << "\n";
+  }
+  out << std::setprecision(3) << "#[Mean    = " << std::setw(12) << histogram.mean() / value_scale << "]\n"
+      << "#[Max     = " << std::setw(12) << static_cast<double>(histogram.max()) / value_scale
+      << ", Total count    = " << std::setw(12) << histogram.count() << "]\n"
+      << "#[Buckets = " << std::setw(12) << histogram.bucket_count()
+      << ", SubBuckets     = " << std::setw(12) << (1 << histogram.precision_bits()) << "]\n";
+  out.flags(flags);
+  out.precision(precision);
+}
+
+// Same, to a file
+void write_percentile_distribution(const LatencyHistogram &histogram, const std::string &filename,
+                                   double value_scale)
+{
+  std::ofstream out(filename, std::ios::binary);
+  if (!out) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+  write_percentile_distribution(histogram, out, value_scale);
+  if (!out) {
+    throw std::runtime_error("Cannot write file: " + filename);
+  }
+}
+
+int SHOW_latency_histogram(void)
+{
+  // Cost of recording
+  LatencyHistogram overhead;
+  for (int i = 0; i < 1'000'000; i++) {
+    LatencyScope scope(overhead);
+  }
+  print_latency_summary("empty LatencyScope", overhead, std::cout);
+
+  // Latency of parse_timestamp on 4 threads, one histogram each, merged
+  const int nb_threads = 4;
+  std::vector<LatencyHistogram> histograms(nb_threads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nb_threads; t++) {
+    threads.emplace_back([&histograms, t] {
+      const std::string texts[] = {"01.02.2013 09:30:00.000", "28.02.2013 23:59:59.999", "15.07.2020 12:00:00"};
+      std::chrono::system_clock::time_point tp;
+      for (int i = 0; i < 1'000'000; i++) {
+        LatencyScope scope(histograms[t]);
+        parse_timestamp(texts[i % 3], TimestampLayout::DMY, tp);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  LatencyHistogram all;
+  for (const LatencyHistogram &h : histograms) {
+    all.merge(h);
+  }
+  print_latency_summary("parse_timestamp, 4 threads", all, std::cout);
+
+  const std::string hgrm = (std::filesystem::temp_directory_path() / "cpp_utils_latency.hgrm").string();
+  write_percentile_distribution(all, hgrm);
+  std::cout << "write_percentile_distribution: " << std::filesystem::file_size(hgrm) << " bytes" << std::endl;
+  std::filesystem::remove(hgrm);
+  return 0;
+}
+
+// end
@@ -0,0 +1,114 @@
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include "stopwatch.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * HDR-style log-linear histogram of non-negative integer values (e.g.
+ * latencies in nanoseconds): each power-of-two range [2^m, 2^(m+1)) is
+ * split into 2^precision_bits equal buckets, so that any value is known
+ * within a relative error of 2^-precision_bits (0.8% with 7 bits), from 0
+ * to 2^64 - 1, in a fixed number of buckets ((65 - precision_bits) <<
+ * precision_bits, 58 KB with 7 bits).
+ *
+ * Recording is O(1) (a bit scan and an increment) and never allocates;
+ * use one histogram per thread and merge them for the whole picture.
+ *
+ * Example:
+ *   LatencyHistogram h;
+ *   for (...) {
+ *     LatencyScope scope(h);
+ *     parse_timestamp(text, layout, tp);
+ *   }
+ *   h.percentile(99.9) // nanoseconds
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+class LatencyHistogram {
+public:
+  explicit LatencyHistogram(int precision_bits = 7);
+
+  void record(uint64_t value) { record(value, 1); }
+  void record(uint64_t value, uint64_t count)
+  {
+    counts[bucket_index(value)] += count;
+    total += count;
+    sum += static_cast<double>(value) * static_cast<double>(count);
+    min_value = value < min_value ? value : min_value;
+    max_value = value > max_value ? value : max_value;
+  }
+
+  void merge(const LatencyHistogram &other);
+  void reset();
+
+  uint64_t count() const { return total; }
+  uint64_t min() const { return total == 0 ? 0 : min_value; }
+  uint64_t max() const { return max_value; }
+  double mean() const { return total == 0 ? 0.0 : sum / static_cast<double>(total); }
+  uint64_t percentile(double p) const;
+
+  int precision_bits() const { return bits; }
+  size_t bucket_count() const { return counts.size(); }
+  uint64_t bucket_count_at(size_t index) const { return counts[index]; }
+  uint64_t bucket_lowest_value(size_t index) const;
+  uint64_t bucket_highest_value(size_t index) const;
+
+  size_t bucket_index(uint64_t value) const
+  {
+    if (value < (uint64_t(1) << bits)) {
+      return static_cast<size_t>(value);
+    }
+    const int magnitude = highest_bit(value); // >= bits
+    const int shift = magnitude - bits;
+    return (static_cast<size_t>(shift + 1) << bits) + static_cast<size_t>((value >> shift) - (uint64_t(1) << bits));
+  }
+
+private:
+  static int highest_bit(uint64_t value)
+  {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+  }
+
+  int bits;
+  std::vector<uint64_t> counts;
+  uint64_t total = 0;
+  double sum = 0.0;
+  uint64_t min_value = UINT64_MAX;
+  uint64_t max_value = 0;
+};
+
+// Records the duration of the enclosing scope, in nanoseconds (Stopwatch)
+class LatencyScope {
+public:
+  explicit LatencyScope(LatencyHistogram &histogram) : histogram(histogram) {}
+  ~LatencyScope() { histogram.record(static_cast<uint64_t>(stopwatch.elapsed_nanoseconds())); }
+  LatencyScope(const LatencyScope &) = delete;
+  LatencyScope &operator=(const LatencyScope &) = delete;
+
+private:
+  LatencyHistogram &histogram;
+  Stopwatch stopwatch; // started last
+};
+
+void print_latency_summary(const std::string &name, const LatencyHistogram &histogram, std::ostream &out);
+void write_percentile_distribution(const LatencyHistogram &histogram, std::ostream &out, double value_scale = 1.0);
+void write_percentile_distribution(const LatencyHistogram &histogram, const std::string &filename,
+                                   double value_scale = 1.0);
+int SHOW_latency_histogram(void);
+
+#endif // LATENCY_HISTOGRAM_HPP
@@ -1,12 +1,31 @@
+#include "allocation_tracker.hpp"
+#include "benchmark.hpp"
+#include "benchmark_report.hpp"
+#include "benchmark_scaling.hpp"
+#include "columnar_dataset.hpp"
+#include "csv_external_sort.hpp"
+#include "csv_parsing.hpp"
+#include "csv_reader.hpp"
+#include "csv_time_search.hpp"
+#include "csv_writer.hpp"
 #include "dates_and_times.hpp"
 #include "doubles.hpp"
 #include "duration.hpp"
 #include "files.hpp"
+#include "files_block_reader.hpp"
+#include "files_line_index.hpp"
+#include "files_parallel_ingest.hpp"
+#include "files_tail_follow.hpp"
+#include "files_windowed.hpp"
 #include "integers_digits.hpp"
 #include "integers_primes.hpp"
+#include "latency_histogram.hpp"
 #include "parallelism_with_async.hpp"
 #include "parallelism_with_openmp.hpp"
 #include "parallelism_with_threads.hpp"
+#include "perf_counters.hpp"
+#include "stopwatch.hpp"
+#include "trace.hpp"
 #include <chrono>
 #include <cstdlib>
 #include <ctime>
@@ -16,8 +35,48 @@
 
 int main()
 {
+  // CPP_UTILS_TRACE=trace.json build/main writes a Chrome trace of the run
+  if (const char *trace = std::getenv("CPP_UTILS_TRACE")) {
+    write_trace_at_exit(trace);
+  }
+  set_trace_thread_name("main");
+  // CPP_UTILS_BENCHMARK_JSON=results.json build/main saves the benchmark results (compare with build/compare_benchmarks)
+  if (const char *results = std::getenv("CPP_UTILS_BENCHMARK_JSON")) {
+    write_benchmark_report_at_exit(results);
+  }
+
   std::cout << "Hello world!" << std::endl;
 
+  std::cout << std::endl;
+  std::cout << "columnar_dataset / SHOW_shared_dataset" << std::endl;
+  std::cout << "--------------------------------------" << std::endl;
+  SHOW_shared_dataset();
+
+  std::cout << std::endl;
+  std::cout << "csv_parsing / SHOW_parse_csv_parallel" << std::endl;
+  std::cout << "-------------------------------------" << std::endl;
+  SHOW_parse_csv_parallel();
+
+  std::cout << std::endl;
+  std::cout << "csv_reader / SHOW_read_ohlcv_csv" << std::endl;
+  std::cout << "--------------------------------" << std::endl;
+  SHOW_read_ohlcv_csv();
+
+  std::cout << std::endl;
+  std::cout << "csv_time_search / SHOW_find_rows_between" << std::endl;
+  std::cout << "----------------------------------------" << std::endl;
+  SHOW_find_rows_between();
+
+  std::cout << std::endl;
+  std::cout << "csv_external_sort / SHOW_sort_csv_files_by_time" << std::endl;
+  std::cout << "-----------------------------------------------" << std::endl;
+  SHOW_sort_csv_files_by_time();
+
+  std::cout << std::endl;
+  std::cout << "csv_writer / SHOW_csv_writer" << std::endl;
+  std::cout << "----------------------------" << std::endl;
+  SHOW_csv_writer();
+
   std::cout << std::endl;
   std::cout << "dates_and_times / parse_date_time_UTC" << std::endl;
   std::cout << "-------------------------------------" << std::endl;
@@ -52,6 +111,16 @@ int main()
   std::cout << "---------------------------" << std::endl;
   SHOW__measure_duration();
 
+  std::cout << std::endl;
+  std::cout << "benchmark / SHOW_benchmark" << std::endl;
+  std::cout << "--------------------------" << std::endl;
+  SHOW_benchmark();
+
+  std::cout << std::endl;
+  std::cout << "benchmark_report / SHOW_benchmark_report" << std::endl;
+  std::cout << "----------------------------------------" << std::endl;
+  SHOW_benchmark_report();
+
   std::cout << std::endl;
   std::cout << "duration / benchmark x 5 (A)" << std::endl;
   std::cout << "---------------------------" << std::endl;
@@ -62,12 +131,72 @@ int main()
   std::cout << "---------------------------" << std::endl;
   SHOW__benchmark_5_times_B();
 
+  std::cout << std::endl;
+  std::cout << "duration / benchmark A versus B" << std::endl;
+  std::cout << "-------------------------------" << std::endl;
+  SHOW__benchmark_A_versus_B();
+
+  std::cout << std::endl;
+  std::cout << "stopwatch / SHOW_stopwatch" << std::endl;
+  std::cout << "--------------------------" << std::endl;
+  SHOW_stopwatch();
+
+  std::cout << std::endl;
+  std::cout << "perf_counters / SHOW_perf_counters" << std::endl;
+  std::cout << "----------------------------------" << std::endl;
+  SHOW_perf_counters();
+
+  std::cout << std::endl;
+  std::cout << "trace / SHOW_trace" << std::endl;
+  std::cout << "------------------" << std::endl;
+  SHOW_trace();
+
+  std::cout << std::endl;
+  std::cout << "latency_histogram / SHOW_latency_histogram" << std::endl;
+  std::cout << "------------------------------------------" << std::endl;
+  SHOW_latency_histogram();
+
+  std::cout << std::endl;
+  std::cout << "allocation_tracker / SHOW_allocation_tracker" << std::endl;
+  std::cout << "--------------------------------------------" << std::endl;
+  SHOW_allocation_tracker();
+
   std::cout << std::endl;
   std::cout << "files / count_lines" << std::endl;
   std::cout << "-------------------" << std::endl;
   std::cout << "Current path: " << std::filesystem::current_path() << std::endl;
   std::cout << "Number of lines in 'src/main.c' file: " << count_lines("./src/main.cpp", false) << std::endl;
 
+  std::cout << std::endl;
+  std::cout << "files_block_reader / SHOW_read_file_by_blocks" << std::endl;
+  std::cout << "---------------------------------------------" << std::endl;
+  SHOW_read_file_by_blocks();
+
+  std::cout << std::endl;
+  std::cout << "files_block_reader / SHOW_read_text_file_by_blocks" << std::endl;
+  std::cout << "--------------------------------------------------" << std::endl;
+  SHOW_read_text_file_by_blocks();
+
+  std::cout << std::endl;
+  std::cout << "files_line_index / SHOW_line_index" << std::endl;
+  std::cout << "----------------------------------" << std::endl;
+  SHOW_line_index();
+
+  std::cout << std::endl;
+  std::cout << "files_parallel_ingest / SHOW_ingest_directory" << std::endl;
+  std::cout << "---------------------------------------------" << std::endl;
+  SHOW_ingest_directory();
+
+  std::cout << std::endl;
+  std::cout << "files_tail_follow / SHOW_tail_follow" << std::endl;
+  std::cout << "------------------------------------" << std::endl;
+  SHOW_tail_follow();
+
+  std::cout << std::endl;
+  std::cout << "files_windowed / SHOW_process_file_in_windows" << std::endl;
+  std::cout << "---------------------------------------------" << std::endl;
+  SHOW_process_file_in_windows();
+
   std::cout << std::endl;
   std::cout << "integers_digits / reverse_number" << std::endl;
   std::cout << "--------------------------------" << std::endl;
@@ -98,6 +227,11 @@ int main()
   std::cout << "parallelism / SHOW_parallelism_with_threads" << std::endl;
   std::cout << "-------------------------------------------" << std::endl;
   SHOW_parallelism_with_threads(1000000000); // 1 billion
+
+  std::cout << std::endl;
+  std::cout << "benchmark_scaling / SHOW_benchmark_scaling" << std::endl;
+  std::cout << "------------------------------------------" << std::endl;
+  SHOW_benchmark_scaling();
   
   return EXIT_SUCCESS;
 }
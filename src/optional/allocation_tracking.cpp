@@ -0,0 +1,168 @@
+#include "allocation_tracker.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32) || defined(__GLIBC__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
+
+// Opt-in part of allocation_tracker.cpp: linking this file replaces the
+// global operator new and delete with counting ones (see
+// allocation_tracker.hpp). It is outside the src/*.cpp wildcard of the
+// Makefile on purpose.
+
+using allocation_tracker_detail::ThreadAllocations;
+using allocation_tracker_detail::thread_allocations;
+
+namespace {
+
+// Size of the block the allocator reserved for p (0 if unknown)
+size_t block_size(void *p, size_t alignment)
+{
+#if defined(_WIN32)
+  return alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? _aligned_msize(p, alignment, 0) : _msize(p);
+#elif defined(__GLIBC__)
+  (void)alignment;
+  return malloc_usable_size(p);
+#elif defined(__APPLE__)
+  (void)alignment;
+  return malloc_size(p);
+#else
+  (void)p;
+  (void)alignment;
+  return 0;
+#endif
+}
+
+void record_allocation(void *p, size_t size, size_t alignment)
+{
+  ThreadAllocations &t = thread_allocations;
+  if (t.depth == 0) {
+    return;
+  }
+  t.allocations++;
+  t.bytes += size;
+  t.live += static_cast<int64_t>(block_size(p, alignment));
+  t.peak = std::max(t.peak, t.live);
+}
+
+void record_deallocation(void *p, size_t alignment)
+{
+  ThreadAllocations &t = thread_allocations;
+  if (t.depth == 0 || p == nullptr) {
+    return;
+  }
+  t.deallocations++;
+  t.live -= static_cast<int64_t>(block_size(p, alignment));
+}
+
+void *try_allocate(size_t size, size_t alignment)
+{
+  if (size == 0) {
+    size = 1;
+  }
+  void *p = nullptr;
+  if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    p = std::malloc(size);
+  } else {
+#if defined(_WIN32)
+    p = _aligned_malloc(size, alignment);
+#else
+    if (::posix_memalign(&p, std::max(alignment, sizeof(void *)), size) != 0) {
+      p = nullptr;
+    }
+#endif
+  }
+  if (p != nullptr) {
+    record_allocation(p, size, alignment);
+  }
+  return p;
+}
+
+// As the standard operator new: calls the new-handler until it succeeds, or throws
+void *allocate(size_t size, size_t alignment)
+{
+  while (true) {
+    if (void *p = try_allocate(size, alignment)) {
+      return p;
+    }
+    std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+void *allocate_nothrow(size_t size, size_t alignment) noexcept
+{
+  try {
+    return allocate(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void deallocate(void *p, size_t alignment) noexcept
+{
+  if (p == nullptr) {
+    return;
+  }
+  record_deallocation(p, alignment);
+#if defined(_WIN32)
+  if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    _aligned_free(p);
+    return;
+  }
+#endif
+  std::free(p);
+}
+
+// Makes allocation_tracking_available() true
+struct Registration {
+  Registration() { allocation_tracker_detail::operators_linked = true; }
+} registration;
+
+} // namespace
+
+// Replacements of the global allocation functions (all C++17 forms)
+void *operator new(size_t size) { return allocate(size, 0); }
+void *operator new[](size_t size) { return allocate(size, 0); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return allocate_nothrow(size, 0); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return allocate_nothrow(size, 0); }
+void *operator new(size_t size, std::align_val_t al) { return allocate(size, static_cast<size_t>(al)); }
+void *operator new[](size_t size, std::align_val_t al) { return allocate(size, static_cast<size_t>(al)); }
+void *operator new(size_t size, std::align_val_t al, const std::nothrow_t &) noexcept
+{
+  return allocate_nothrow(size, static_cast<size_t>(al));
+}
+void *operator new[](size_t size, std::align_val_t al, const std::nothrow_t &) noexcept
+{
+  return allocate_nothrow(size, static_cast<size_t>(al));
+}
+
+void operator delete(void *p) noexcept { deallocate(p, 0); }
+void operator delete[](void *p) noexcept { deallocate(p, 0); }
+void operator delete(void *p, size_t) noexcept { deallocate(p, 0); }
+void operator delete[](void *p, size_t) noexcept { deallocate(p, 0); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { deallocate(p, 0); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { deallocate(p, 0); }
+void operator delete(void *p, std::align_val_t al) noexcept { deallocate(p, static_cast<size_t>(al)); }
+void operator delete[](void *p, std::align_val_t al) noexcept { deallocate(p, static_cast<size_t>(al)); }
+void operator delete(void *p, size_t, std::align_val_t al) noexcept { deallocate(p, static_cast<size_t>(al)); }
+void operator delete[](void *p, size_t, std::align_val_t al) noexcept { deallocate(p, static_cast<size_t>(al)); }
+void operator delete(void *p, std::align_val_t al, const std::nothrow_t &) noexcept
+{
+  deallocate(p, static_cast<size_t>(al));
+}
+void operator delete[](void *p, std::align_val_t al, const std::nothrow_t &) noexcept
+{
+  deallocate(p, static_cast<size_t>(al));
+}
+
+// end
@@ -1,3 +1,5 @@
+#include "parallelism_with_async.hpp"
+#include "stopwatch.hpp"
 #include <algorithm>
 #include <chrono>
 #include <cstdint>
@@ -5,10 +7,8 @@
 #include <iostream>
 #include <vector>
 
-double SHOW_parallelism_with_async(uint64_t n) {
-    auto start = std::chrono::high_resolution_clock::now();
-    
-    const int num_tasks = 32;
+// Leibniz formula for pi over num_tasks std::async tasks (one thread each)
+double leibniz_pi_with_async(uint64_t n, int num_tasks) {
     std::vector<std::future<double>> futures;
     futures.reserve(num_tasks);
     
@@ -36,10 +36,16 @@ double SHOW_parallelism_with_async(uint64_t n) {
     for (auto& future : futures) {
         result += future.get();
     }
-    result *= 4.0;
+    return result * 4.0;
+}
+
+double SHOW_parallelism_with_async(uint64_t n) {
+    Stopwatch sw;
+    
+    const int num_tasks = 32;
+    double result = leibniz_pi_with_async(n, num_tasks);
     
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> duration = end - start;
+    std::chrono::duration<double> duration = sw.elapsed();
     
     std::cout << "[std::async] pi = " << result 
               << " (in " << duration.count() << " s, " 
@@ -3,6 +3,7 @@
 
 #include <cstdint>
 
+double leibniz_pi_with_async(uint64_t n, int num_tasks);
 double SHOW_parallelism_with_async(uint64_t n);
 
 #endif // PARALLELISM_WITH_ASYNC_HPP
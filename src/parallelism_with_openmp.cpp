@@ -1,45 +1,31 @@
+#include "parallelism_with_openmp.hpp"
+#include "stopwatch.hpp"
 #include <cstdint>
 #include <cstdio>
-#include <ctime>
 #include <omp.h>
 
 // Compile with: -fopenmp -march=native
 
-// With reduction:
-double SHOW_parallelism_with_openmp_1(uint64_t n)
+// With reduction, on num_threads threads:
+double leibniz_pi_with_openmp_reduction(uint64_t n, int num_threads)
 {
-  timespec start_time, end_time;
-  clock_gettime(CLOCK_MONOTONIC, &start_time);
-  
   double tmp = 0.0;
   
-#pragma omp parallel for schedule(static) reduction(+ : tmp)
+#pragma omp parallel for schedule(static) reduction(+ : tmp) num_threads(num_threads)
   for (uint64_t i = 0; i < n; i++) {
     double sign = (i & 1) ? -1.0 : 1.0;
     tmp += sign / (2.0 * i + 1.0);
   }
   
-  tmp *= 4.0;
-  
-  clock_gettime(CLOCK_MONOTONIC, &end_time);
-  double duration = (end_time.tv_sec - start_time.tv_sec) +
-                    (end_time.tv_nsec - start_time.tv_nsec) / 1e9;
-  
-  std::printf("Leibniz formula: pi = %.20f (in %f s)\n", tmp, duration);
-  std::fflush(stdout);
-  
-  return duration;
+  return tmp * 4.0;
 }
 
-// Without reduction:
-double SHOW_parallelism_with_openmp_2(uint64_t n)
+// Without reduction, on num_threads threads:
+double leibniz_pi_with_openmp_atomic(uint64_t n, int num_threads)
 {
-  timespec start_time, end_time;
-  clock_gettime(CLOCK_MONOTONIC, &start_time);
-  
   double tmp = 0.0;
   
-#pragma omp parallel
+#pragma omp parallel num_threads(num_threads)
   {
     double local_sum = 0.0;
     
@@ -53,11 +39,32 @@ double SHOW_parallelism_with_openmp_2(uint64_t n)
     tmp += local_sum;
   }
   
-  tmp *= 4.0;
+  return tmp * 4.0;
+}
+
+// With reduction:
+double SHOW_parallelism_with_openmp_1(uint64_t n)
+{
+  Stopwatch sw;
+  
+  double tmp = leibniz_pi_with_openmp_reduction(n, omp_get_max_threads());
+  
+  double duration = sw.elapsed_seconds();
+  
+  std::printf("Leibniz formula: pi = %.20f (in %f s)\n", tmp, duration);
+  std::fflush(stdout);
+  
+  return duration;
+}
+
+// Without reduction:
+double SHOW_parallelism_with_openmp_2(uint64_t n)
+{
+  Stopwatch sw;
+  
+  double tmp = leibniz_pi_with_openmp_atomic(n, omp_get_max_threads());
   
-  clock_gettime(CLOCK_MONOTONIC, &end_time);
-  double duration = (end_time.tv_sec - start_time.tv_sec) +
-                    (end_time.tv_nsec - start_time.tv_nsec) / 1e9;
+  double duration = sw.elapsed_seconds();
   
   std::printf("Leibniz formula: pi = %.20f (in %f s)\n", tmp, duration);
   std::fflush(stdout);
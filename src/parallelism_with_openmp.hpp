@@ -3,6 +3,8 @@
 
 #include <cstdint>
 
+double leibniz_pi_with_openmp_reduction(uint64_t n, int num_threads);
+double leibniz_pi_with_openmp_atomic(uint64_t n, int num_threads);
 double SHOW_parallelism_with_openmp_1(uint64_t n);
 double SHOW_parallelism_with_openmp_2(uint64_t n);
 
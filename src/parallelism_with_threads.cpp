@@ -1,3 +1,6 @@
+#include "parallelism_with_threads.hpp"
+#include "stopwatch.hpp"
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
@@ -26,9 +29,11 @@ private:
     
     int task_count;
     int next_task;
+    int completed_tasks;
     
     std::mutex queue_mutex;
     std::condition_variable queue_cond;
+    std::condition_variable done_cond;
     bool shutdown;
     
     // Worker thread function
@@ -58,13 +63,18 @@ private:
                 local_sum += sign / (2.0 * i + 1.0);
             }
             task.result = local_sum;
+            
+            lock.lock();
+            if (++completed_tasks == task_count) {
+                done_cond.notify_all();
+            }
         }
     }
 
 public:
     // Constructor
     ThreadPool(int num_threads) 
-        : task_count(0), next_task(0), shutdown(false) {
+        : task_count(0), next_task(0), completed_tasks(0), shutdown(false) {
         tasks.reserve(1024);
         
         // Create worker threads
@@ -95,6 +105,7 @@ public:
         
         task_count = num_tasks;
         next_task = 0;
+        completed_tasks = 0;
         
         tasks.clear();
         tasks.resize(num_tasks);
@@ -110,15 +121,10 @@ public:
         queue_cond.notify_all();
     }
     
-    // Wait for all tasks to complete
+    // Wait for all tasks to complete (not only to be taken by a worker)
     void wait() {
-        while (true) {
-            std::lock_guard<std::mutex> lock(queue_mutex);
-            if (next_task >= task_count) {
-                break;
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        }
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        done_cond.wait(lock, [this] { return completed_tasks >= task_count; });
     }
     
     // Get results
@@ -131,11 +137,8 @@ public:
     }
 };
 
-// Main computation function using thread pool
-double SHOW_parallelism_with_threads(uint64_t n) {
-    auto start_time = std::chrono::high_resolution_clock::now();
-    
-    const int num_threads = 8;
+// Leibniz formula for pi with a pool of num_threads threads, over 4 tasks per thread
+double leibniz_pi_with_threads(uint64_t n, int num_threads) {
     const int num_tasks = num_threads * 4;
     
     ThreadPool pool(num_threads);
@@ -147,10 +150,19 @@ double SHOW_parallelism_with_threads(uint64_t n) {
     pool.wait();
     
     // Collect results
-    double tmp = pool.get_results() * 4.0;
+    return pool.get_results() * 4.0;
+}
+
+// Main computation function using thread pool
+double SHOW_parallelism_with_threads(uint64_t n) {
+    Stopwatch sw;
+    
+    const int num_threads = 8;
+    const int num_tasks = num_threads * 4;
+    
+    double tmp = leibniz_pi_with_threads(n, num_threads);
     
-    auto end_time = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> duration = end_time - start_time;
+    std::chrono::duration<double> duration = sw.elapsed();
     
     std::cout << "Leibniz formula: pi = " << std::fixed << tmp 
               << " (in " << duration.count() << " s, " 
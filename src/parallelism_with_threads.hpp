@@ -3,6 +3,7 @@
 
 #include <cstdint>
 
+double leibniz_pi_with_threads(uint64_t n, int num_threads);
 double SHOW_parallelism_with_threads(uint64_t n);
 
 #endif // PARALLELISM_WITH_THREADS_HPP
@@ -0,0 +1,247 @@
+#include "perf_counters.hpp"
+#include "integers_primes.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#if defined(__linux__)
+
+// perf_event_attr type and config of each counter, in PerfCounter bit order
+struct CounterConfig {
+  uint32_t type;
+  uint64_t config;
+  const char *name;
+};
+
+constexpr uint64_t cache_miss(uint64_t cache)
+{
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+const CounterConfig counter_configs[] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles"},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions"},
+    {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D), "L1d misses"},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, "LLC misses"},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, "branch misses"},
+    {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_DTLB), "dTLB misses"},
+};
+
+// Opens a counter, as the leader of a new group (group_fd = -1, created
+// disabled) or as a member of the group of group_fd (enabled with it)
+int open_counter(const CounterConfig &counter, int group_fd)
+{
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = counter.type;
+  attr.config = counter.config;
+  attr.disabled = group_fd < 0 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC));
+}
+
+constexpr size_t max_group_size = sizeof(counter_configs) / sizeof(counter_configs[0]);
+
+// Counts of a group, in the order its counters were opened, scaled for
+// multiplexing; the counters of a group are scheduled together, so their
+// ratios are exact (counts left unchanged if the group never ran)
+void read_group(int leader_fd, uint64_t *counts, size_t nb_counts)
+{
+  uint64_t values[3 + max_group_size] = {}; // number of counters, time enabled, time running, counts
+  ssize_t expected = static_cast<ssize_t>((3 + nb_counts) * sizeof(uint64_t));
+  if (::read(leader_fd, values, sizeof(values)) != expected || values[0] != nb_counts || values[2] == 0) {
+    return;
+  }
+  for (size_t i = 0; i < nb_counts; i++) {
+    counts[i] = values[3 + i];
+    if (values[2] < values[1]) {
+      counts[i] = static_cast<uint64_t>(static_cast<double>(values[3 + i]) * static_cast<double>(values[1]) /
+                                        static_cast<double>(values[2]));
+    }
+  }
+}
+
+#endif
+
+} // namespace
+
+PerfCounts &PerfCounts::operator+=(const PerfCounts &other)
+{
+  available |= other.available;
+  cycles += other.cycles;
+  instructions += other.instructions;
+  l1d_misses += other.l1d_misses;
+  llc_misses += other.llc_misses;
+  branch_misses += other.branch_misses;
+  dtlb_misses += other.dtlb_misses;
+  return *this;
+}
+
+PerfCounterGroup::PerfCounterGroup(unsigned counters)
+{
+#if defined(__linux__)
+  int leader = -1;
+  for (int i = 0; i < nb_counters; i++) {
+    if ((counters & (1u << i)) == 0) {
+      continue;
+    }
+    fds[i] = leader >= 0 ? open_counter(counter_configs[i], fds[leader]) : -1;
+    if (fds[i] >= 0) {
+      leaders[i] = leader;
+    } else {
+      // First counter, or the group is full (EINVAL): lead a new group
+      fds[i] = open_counter(counter_configs[i], -1);
+      if (fds[i] >= 0) {
+        leader = leaders[i] = i;
+      }
+    }
+    if (fds[i] >= 0) {
+      opened |= 1u << i;
+    } else if (reason.empty()) {
+      reason = std::string("perf_event_open failed for ") + counter_configs[i].name + ": " + std::strerror(errno);
+      if (errno == EACCES || errno == EPERM) {
+        reason += " (see /proc/sys/kernel/perf_event_paranoid)";
+      } else if (errno == ENOENT || errno == EOPNOTSUPP) {
+        reason += " (no hardware counters, e.g. in a virtual machine)";
+      }
+    }
+  }
+#else
+  (void)counters;
+  reason = "Hardware counters are only supported on Linux";
+#endif
+}
+
+PerfCounterGroup::~PerfCounterGroup()
+{
+#if defined(__linux__)
+  for (int fd : fds) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+#endif
+}
+
+void PerfCounterGroup::start()
+{
+#if defined(__linux__)
+  for (int i = 0; i < nb_counters; i++) {
+    if (fds[i] >= 0 && leaders[i] == i) {
+      ::ioctl(fds[i], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ::ioctl(fds[i], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+  }
+#endif
+}
+
+PerfCounts PerfCounterGroup::stop()
+{
+  PerfCounts counts;
+  counts.available = opened;
+#if defined(__linux__)
+  for (int i = 0; i < nb_counters; i++) {
+    if (fds[i] >= 0 && leaders[i] == i) {
+      ::ioctl(fds[i], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+  }
+  uint64_t *fields[nb_counters] = {&counts.cycles,        &counts.instructions,  &counts.l1d_misses,
+                                   &counts.llc_misses,    &counts.branch_misses, &counts.dtlb_misses};
+  for (int i = 0; i < nb_counters; i++) {
+    if (fds[i] < 0 || leaders[i] != i) {
+      continue;
+    }
+    int members[nb_counters];
+    size_t nb_members = 0;
+    for (int j = i; j < nb_counters; j++) {
+      if (fds[j] >= 0 && leaders[j] == i) {
+        members[nb_members++] = j;
+      }
+    }
+    uint64_t values[nb_counters] = {};
+    read_group(fds[i], values, nb_members);
+    for (size_t m = 0; m < nb_members; m++) {
+      *fields[members[m]] = values[m];
+    }
+  }
+#endif
+  return counts;
+}
+
+/**
+ * Prints counts per item (e.g. per number sieved, per row parsed):
+ * cycles, instructions, IPC and misses, for the available counters.
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+void print_perf_counts(const PerfCounts &counts, double nb_items, std::ostream &out)
+{
+  if (counts.available == 0) {
+    out << "  hardware counters unavailable" << std::endl;
+    return;
+  }
+  auto flags = out.flags();
+  auto precision = out.precision();
+  out << std::fixed << std::setprecision(3) << "  per item:";
+  auto per_item = [&](unsigned counter, uint64_t value, const char *name) {
+    if (counts.available & counter) {
+      out << " " << static_cast<double>(value) / nb_items << " " << name << ",";
+    }
+  };
+  per_item(PERF_CYCLES, counts.cycles, "cycles");
+  per_item(PERF_INSTRUCTIONS, counts.instructions, "instructions");
+  per_item(PERF_L1D_MISSES, counts.l1d_misses, "L1d misses");
+  per_item(PERF_LLC_MISSES, counts.llc_misses, "LLC misses");
+  per_item(PERF_BRANCH_MISSES, counts.branch_misses, "branch misses");
+  per_item(PERF_DTLB_MISSES, counts.dtlb_misses, "dTLB misses");
+  if ((counts.available & (PERF_CYCLES | PERF_INSTRUCTIONS)) == (PERF_CYCLES | PERF_INSTRUCTIONS)) {
+    out << " IPC " << counts.ipc();
+  }
+  out << std::endl;
+  out.flags(flags);
+  out.precision(precision);
+}
+
+int SHOW_perf_counters(void)
+{
+  PerfCounterGroup counters;
+  if (counters.empty()) {
+    std::cout << "No hardware counter: " << counters.unavailable_reason() << std::endl;
+  } else if (counters.counters() != PERF_ALL) {
+    std::cout << "Some hardware counters are unavailable: " << counters.unavailable_reason() << std::endl;
+  }
+
+  // Small sieve (fits in cache) versus large one
+  for (long long n : {100'000LL, 100'000'000LL}) {
+    PerfCounts counts;
+    size_t nb_primes = 0;
+    {
+      PerfScope scope(counters, counts);
+      std::vector<bool> sieve = sieve_eratosthenes(n);
+      for (bool is_prime : sieve) {
+        nb_primes += is_prime;
+      }
+    }
+    std::cout << "sieve_eratosthenes(" << n << "): " << nb_primes << " primes" << std::endl;
+    print_perf_counts(counts, static_cast<double>(n), std::cout);
+  }
+  return 0;
+}
+
+// end
@@ -0,0 +1,91 @@
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// Hardware counters, as bits of a mask
+enum PerfCounter : unsigned {
+  PERF_CYCLES = 1,
+  PERF_INSTRUCTIONS = 2,
+  PERF_L1D_MISSES = 4,
+  PERF_LLC_MISSES = 8,
+  PERF_BRANCH_MISSES = 16,
+  PERF_DTLB_MISSES = 32,
+  PERF_ALL = 63
+};
+
+struct PerfCounts {
+  unsigned available = 0; // PerfCounter bits actually counted (others are 0)
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  uint64_t l1d_misses = 0;    // L1 data cache read misses
+  uint64_t llc_misses = 0;    // last-level cache misses
+  uint64_t branch_misses = 0; // mispredicted branches
+  uint64_t dtlb_misses = 0;   // data TLB read misses
+
+  double ipc() const { return cycles > 0 ? static_cast<double>(instructions) / static_cast<double>(cycles) : 0.0; }
+  PerfCounts &operator+=(const PerfCounts &other);
+};
+
+/**
+ * Set of hardware performance counters of the calling thread (Linux
+ * perf_event_open, user space only), started and stopped around a region.
+ *
+ * Counters that cannot be opened (no PMU, e.g. in a virtual machine;
+ * perf_event_paranoid too restrictive; other OS) are left out: the group
+ * is then partial or empty, never an error, and unavailable_reason() tells
+ * why. The counters are opened as one perf group, so that they count over
+ * the same cycles and their ratios (IPC) are exact; when the PMU cannot
+ * hold them all, the remaining ones form further groups, which the
+ * kernel multiplexes, and their counts are scaled by enabled / running
+ * time. Cycles and instructions always share the first group.
+ *
+ * Example:
+ *   PerfCounterGroup counters;
+ *   counters.start();
+ *   sieve_eratosthenes(10'000'000);
+ *   PerfCounts counts = counters.stop();
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+class PerfCounterGroup {
+public:
+  explicit PerfCounterGroup(unsigned counters = PERF_ALL);
+  ~PerfCounterGroup();
+  PerfCounterGroup(const PerfCounterGroup &) = delete;
+  PerfCounterGroup &operator=(const PerfCounterGroup &) = delete;
+
+  unsigned counters() const { return opened; }
+  bool empty() const { return opened == 0; }
+  const std::string &unavailable_reason() const { return reason; }
+
+  void start();
+  PerfCounts stop();
+
+private:
+  static constexpr int nb_counters = 6;
+  int fds[nb_counters] = {-1, -1, -1, -1, -1, -1};
+  int leaders[nb_counters] = {-1, -1, -1, -1, -1, -1}; // index of the group leader of each counter
+  unsigned opened = 0;
+  std::string reason;
+};
+
+// Counts of a scoped region, added to `total` when the scope ends
+class PerfScope {
+public:
+  PerfScope(PerfCounterGroup &group, PerfCounts &total) : group(group), total(total) { group.start(); }
+  ~PerfScope() { total += group.stop(); }
+  PerfScope(const PerfScope &) = delete;
+  PerfScope &operator=(const PerfScope &) = delete;
+
+private:
+  PerfCounterGroup &group;
+  PerfCounts &total;
+};
+
+void print_perf_counts(const PerfCounts &counts, double nb_items, std::ostream &out);
+int SHOW_perf_counters(void);
+
+#endif // PERF_COUNTERS_HPP
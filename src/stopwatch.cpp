@@ -0,0 +1,184 @@
+#include "stopwatch.hpp"
+#include "doubles.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(STOPWATCH_X86) && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+#if !defined(_WIN32)
+#include <time.h>
+#endif
+
+namespace {
+
+// CPUID.80000007H:EDX[8]: invariant TSC
+bool cpu_has_invariant_tsc()
+{
+#if defined(STOPWATCH_X86) && defined(_MSC_VER)
+  int regs[4];
+  __cpuid(regs, 0x80000000);
+  if (static_cast<unsigned>(regs[0]) < 0x80000007u) {
+    return false;
+  }
+  __cpuid(regs, 0x80000007);
+  return (regs[3] & (1 << 8)) != 0;
+#elif defined(STOPWATCH_X86)
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007u) {
+    return false;
+  }
+  __cpuid(0x80000007, eax, ebx, ecx, edx);
+  return (edx & (1u << 8)) != 0;
+#else
+  return false;
+#endif
+}
+
+// CLOCK_MONOTONIC, in nanoseconds
+int64_t monotonic_nanoseconds()
+{
+#if defined(_WIN32)
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+#endif
+}
+
+#if defined(STOPWATCH_X86)
+
+// TSC read closest in time to a CLOCK_MONOTONIC read: among a few tries,
+// the one where the clock read is bracketed by the tightest pair of TSC reads
+void paired_reading(uint64_t &tsc, int64_t &nanoseconds)
+{
+  uint64_t best_gap = UINT64_MAX;
+  for (int i = 0; i < 16; i++) {
+    uint64_t before = __rdtsc();
+    int64_t ns = monotonic_nanoseconds();
+    uint64_t after = __rdtsc();
+    if (after - before < best_gap) {
+      best_gap = after - before;
+      tsc = before + (after - before) / 2;
+      nanoseconds = ns;
+    }
+  }
+}
+
+#endif
+
+// Median of the rate measured over 3 intervals of 5 ms
+double measure_tsc_rate()
+{
+#if defined(STOPWATCH_X86)
+  std::vector<double> rates;
+  for (int i = 0; i < 3; i++) {
+    uint64_t tsc0 = 0, tsc1 = 0;
+    int64_t ns0 = 0, ns1 = 0;
+    paired_reading(tsc0, ns0);
+    while (monotonic_nanoseconds() - ns0 < 5'000'000) {
+    }
+    paired_reading(tsc1, ns1);
+    rates.push_back(static_cast<double>(tsc1 - tsc0) * 1e9 / static_cast<double>(ns1 - ns0));
+  }
+  std::sort(rates.begin(), rates.end());
+  return rates[1];
+#else
+  return 1e9;
+#endif
+}
+
+// Calibrated when the program starts, rather than during a first measurement
+const bool calibrated_at_startup = stopwatch_calibration().ticks_per_second > 0.0;
+
+} // namespace
+
+/**
+ * Detects whether the TSC is usable (x86, invariant TSC), measures its
+ * rate against CLOCK_MONOTONIC (about 15 ms) and the overhead of an empty
+ * measurement. Called once, by stopwatch_calibration().
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+StopwatchCalibration calibrate_stopwatch()
+{
+  StopwatchCalibration calibration;
+  calibration.invariant_tsc = cpu_has_invariant_tsc();
+  calibration.uses_tsc = calibration.invariant_tsc;
+  if (calibration.uses_tsc) {
+    calibration.ticks_per_second = measure_tsc_rate();
+  }
+
+  // Smallest of many empty start/stop pairs, read as Stopwatch does
+  uint64_t overhead = UINT64_MAX;
+  for (int i = 0; i < 1000; i++) {
+    uint64_t begin, end;
+#if defined(STOPWATCH_X86)
+    if (calibration.uses_tsc) {
+      unsigned int aux;
+      _mm_lfence();
+      begin = __rdtsc();
+      _mm_lfence();
+      end = __rdtscp(&aux);
+      _mm_lfence();
+    } else
+#endif
+    {
+      begin = static_cast<uint64_t>(monotonic_nanoseconds());
+      end = static_cast<uint64_t>(monotonic_nanoseconds());
+    }
+    overhead = std::min(overhead, end - begin);
+  }
+  calibration.overhead_ticks = static_cast<double>(overhead);
+  return calibration;
+}
+
+double ticks_to_seconds(double ticks)
+{
+  return ticks / stopwatch_calibration().ticks_per_second;
+}
+
+int SHOW_stopwatch(void)
+{
+  const StopwatchCalibration &calibration = stopwatch_calibration();
+  std::cout << "Invariant TSC: " << (calibration.invariant_tsc ? "yes" : "no") << ", clock: "
+            << (calibration.uses_tsc ? "TSC at " : "steady_clock, ") << std::fixed << std::setprecision(3)
+            << calibration.ticks_per_second / 1e9 << " GHz" << std::endl;
+  std::cout << "Overhead of an empty measurement: " << ticks_to_seconds(calibration.overhead_ticks) * 1e9 << " ns"
+            << std::endl;
+
+  // Overhead of steady_clock, for comparison
+  double steady_overhead = 1e9;
+  for (int i = 0; i < 1000; i++) {
+    auto begin = std::chrono::steady_clock::now();
+    auto end = std::chrono::steady_clock::now();
+    steady_overhead = std::min(steady_overhead, std::chrono::duration<double, std::nano>(end - begin).count());
+  }
+  std::cout << "Overhead of an empty steady_clock measurement: " << steady_overhead << " ns" << std::endl;
+
+  // A single parse_double call, measured 10'000 times
+  const std::string text = "1,36115";
+  std::vector<double> nanoseconds;
+  double sum = 0.0;
+  for (int i = 0; i < 10'000; i++) {
+    Stopwatch sw;
+    sum += parse_double(text, ',');
+    nanoseconds.push_back(sw.elapsed_nanoseconds());
+  }
+  std::sort(nanoseconds.begin(), nanoseconds.end());
+  double overhead_ns = ticks_to_seconds(calibration.overhead_ticks) * 1e9;
+  std::cout << "One parse_double call: median " << nanoseconds[nanoseconds.size() / 2] - overhead_ns
+            << " ns, min " << nanoseconds.front() - overhead_ns << " ns (overhead subtracted; checksum " << sum
+            << ")" << std::endl;
+  std::cout.unsetf(std::ios::fixed);
+  std::cout << std::setprecision(6);
+  return 0;
+}
+
+// end
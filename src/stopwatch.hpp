@@ -0,0 +1,102 @@
+#ifndef STOPWATCH_HPP
+#define STOPWATCH_HPP
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define STOPWATCH_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+struct StopwatchCalibration {
+  bool uses_tsc = false;          // false: steady_clock fallback, one tick = 1 ns
+  bool invariant_tsc = false;     // CPUID reports a constant-rate TSC, not stopped in deep C-states
+  double ticks_per_second = 1e9;  // measured against CLOCK_MONOTONIC
+  double overhead_ticks = 0.0;    // cost of an empty start/stop pair
+};
+
+StopwatchCalibration calibrate_stopwatch();
+
+// Calibration done once (when the program starts, see stopwatch.cpp)
+inline const StopwatchCalibration &stopwatch_calibration()
+{
+  static const StopwatchCalibration calibration = calibrate_stopwatch();
+  return calibration;
+}
+
+// Time-stamp counter read at the start of a measured section: the lfences
+// keep earlier instructions from completing after it, and later ones from
+// starting before it
+inline uint64_t stopwatch_ticks_begin()
+{
+#if defined(STOPWATCH_X86)
+  if (stopwatch_calibration().uses_tsc) {
+    _mm_lfence();
+    uint64_t ticks = __rdtsc();
+    _mm_lfence();
+    return ticks;
+  }
+#endif
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+
+// Time-stamp counter read at the end of a measured section: rdtscp waits
+// for earlier instructions, the lfence keeps later ones from starting before
+inline uint64_t stopwatch_ticks_end()
+{
+#if defined(STOPWATCH_X86)
+  if (stopwatch_calibration().uses_tsc) {
+    unsigned int aux;
+    uint64_t ticks = __rdtscp(&aux);
+    _mm_lfence();
+    return ticks;
+  }
+#endif
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+
+/**
+ * Stopwatch on the time-stamp counter (rdtsc / rdtscp with lfence), with
+ * a resolution of about a nanosecond and an overhead of a few dozen
+ * cycles, to time hot paths down to sub-microsecond durations.
+ *
+ * The TSC is used only if it is invariant (constant rate, synchronized
+ * across cores); its rate is calibrated against CLOCK_MONOTONIC when the
+ * program starts. Otherwise, and on other architectures, steady_clock is
+ * used, with ticks in nanoseconds.
+ *
+ * Example:
+ *   Stopwatch sw;
+ *   double x = parse_double("1,36115", ',');
+ *   double ns = sw.elapsed_nanoseconds();
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+class Stopwatch {
+public:
+  Stopwatch() : start_ticks(stopwatch_ticks_begin()) {}
+
+  void restart() { start_ticks = stopwatch_ticks_begin(); }
+
+  uint64_t elapsed_ticks() const { return stopwatch_ticks_end() - start_ticks; }
+  double elapsed_seconds() const { return static_cast<double>(elapsed_ticks()) / stopwatch_calibration().ticks_per_second; }
+  double elapsed_nanoseconds() const { return 1e9 * elapsed_seconds(); }
+  std::chrono::duration<double> elapsed() const { return std::chrono::duration<double>(elapsed_seconds()); }
+
+private:
+  uint64_t start_ticks;
+};
+
+double ticks_to_seconds(double ticks);
+int SHOW_stopwatch(void);
+
+#endif // STOPWATCH_HPP
@@ -0,0 +1,253 @@
+#include "trace.hpp"
+#include "csv_external_sort.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Buffers of all threads that traced, kept after the threads exit; never
+// destroyed, so that tracing and the at-exit dump work during static
+// destruction. The buffers of exited threads are reused, so that there are
+// never more buffers than threads tracing at the same time
+struct TraceRegistry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<TraceBuffer>> buffers;
+  std::vector<TraceBuffer *> free_buffers;
+  std::string exit_filename;
+};
+
+TraceRegistry &registry()
+{
+  static TraceRegistry *instance = new TraceRegistry();
+  return *instance;
+}
+
+void write_trace_on_exit()
+{
+  std::string filename;
+  {
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    filename = registry().exit_filename;
+  }
+  try {
+    write_trace(filename);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+  }
+}
+
+} // namespace
+
+// Writes s as a JSON string literal ('"', '\\' and control characters escaped)
+void write_json_string(std::ostream &out, const std::string &s)
+{
+  out << '"';
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      out << escaped;
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+// Buffer of an exited thread if any (its events stay, on the same track), else a new one
+TraceBuffer *register_trace_thread()
+{
+  TraceRegistry &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  if (!r.free_buffers.empty()) {
+    TraceBuffer *buffer = r.free_buffers.back();
+    r.free_buffers.pop_back();
+    return buffer;
+  }
+  r.buffers.push_back(std::make_unique<TraceBuffer>(static_cast<uint32_t>(r.buffers.size() + 1)));
+  return r.buffers.back().get();
+}
+
+void release_trace_thread(TraceBuffer *buffer)
+{
+  TraceRegistry &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  r.free_buffers.push_back(buffer);
+}
+
+// Name of the calling thread in the trace
+void set_trace_thread_name(const std::string &name)
+{
+  TraceBuffer &buffer = trace_buffer();
+  std::lock_guard<std::mutex> lock(registry().mutex);
+  buffer.thread_name = name;
+}
+
+/**
+ * Writes the events recorded by TRACE_SCOPE, in all threads, as a Chrome
+ * trace (JSON "complete" events, in microseconds from the first event),
+ * to be opened in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Each thread keeps its last TraceBuffer::capacity events. A thread that
+ * starts tracing after another exited takes over its buffer, hence its
+ * track (tid) and the room left in it. Meant to be called when threads
+ * are not tracing (e.g. at exit); otherwise, events being overwritten
+ * during the copy are dropped.
+ *
+ * @param filename Path to the JSON file
+ * @return size_t Number of events written
+ * @throws std::runtime_error if the file cannot be written
+ *
+ * Example:
+ *   write_trace("trace.json")
+ *
+ * (v1, available in occisn/cpp-utils GitHub repository, 2026-10-19)
+ */
+size_t write_trace(const std::string &filename)
+{
+  struct ThreadEvents {
+    uint32_t tid;
+    std::string name;
+    std::vector<TraceEvent> events;
+  };
+  std::vector<ThreadEvents> threads;
+  {
+    TraceRegistry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const auto &buffer : r.buffers) {
+      uint64_t head = buffer->head.load(std::memory_order_acquire);
+      uint64_t first = head > TraceBuffer::capacity ? head - TraceBuffer::capacity : 0;
+      ThreadEvents thread{buffer->tid, buffer->thread_name, {}};
+      for (uint64_t i = first; i < head; i++) {
+        thread.events.push_back(buffer->events[i & (TraceBuffer::capacity - 1)]);
+      }
+      // Drop the events overwritten meanwhile
+      uint64_t after = buffer->head.load(std::memory_order_acquire);
+      if (after > first + TraceBuffer::capacity) {
+        size_t lost = std::min<size_t>(thread.events.size(), after - first - TraceBuffer::capacity);
+        thread.events.erase(thread.events.begin(), thread.events.begin() + static_cast<std::ptrdiff_t>(lost));
+      }
+      threads.push_back(std::move(thread));
+    }
+  }
+
+  uint64_t origin = UINT64_MAX;
+  for (const ThreadEvents &thread : threads) {
+    for (const TraceEvent &event : thread.events) {
+      origin = std::min(origin, event.begin);
+    }
+  }
+  const double microseconds_per_tick = 1e6 / stopwatch_calibration().ticks_per_second;
+
+  std::ofstream out(filename, std::ios::binary);
+  if (!out) {
+    throw std::runtime_error("Cannot open file: " + filename);
+  }
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  out.precision(3);
+  out << std::fixed;
+  size_t nb_events = 0;
+  bool first = true;
+  for (const ThreadEvents &thread : threads) {
+    if (!thread.name.empty()) {
+      out << (first ? "\n" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << thread.tid
+          << ",\"args\":{\"name\":";
+      write_json_string(out, thread.name);
+      out << "}}";
+      first = false;
+    }
+    for (const TraceEvent &event : thread.events) {
+      out << (first ? "\n" : ",\n") << "{\"ph\":\"X\",\"name\":";
+      write_json_string(out, event.name);
+      out << ",\"pid\":1,\"tid\":" << thread.tid
+          << ",\"ts\":" << static_cast<double>(event.begin - origin) * microseconds_per_tick
+          << ",\"dur\":" << static_cast<double>(event.end - event.begin) * microseconds_per_tick << "}";
+      first = false;
+      nb_events++;
+    }
+  }
+  out << "\n]}\n";
+  if (!out) {
+    throw std::runtime_error("Cannot write file: " + filename);
+  }
+  return nb_events;
+}
+
+// Writes the trace to filename when the program exits (std::atexit)
+void write_trace_at_exit(const std::string &filename)
+{
+  TraceRegistry &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  if (r.exit_filename.empty()) {
+    std::atexit(write_trace_on_exit);
+  }
+  r.exit_filename = filename;
+}
+
+// Forgets the recorded events (to be called when no thread is tracing)
+void clear_trace()
+{
+  TraceRegistry &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  for (const auto &buffer : r.buffers) {
+    buffer->head.store(0, std::memory_order_release);
+  }
+}
+
+int SHOW_trace(void)
+{
+  // Cost of an event
+  const int nb_scopes = 1'000'000;
+  Stopwatch sw;
+  for (int i = 0; i < nb_scopes; i++) {
+    TRACE_SCOPE("empty scope");
+  }
+  double ns_per_event = sw.elapsed_nanoseconds() / nb_scopes;
+  clear_trace();
+  std::cout << "TRACE_SCOPE: " << ns_per_event << " ns per event" << std::endl;
+
+  // A traced multi-stage run, over several threads
+  set_trace_thread_name("main");
+  const std::filesystem::path directory = std::filesystem::temp_directory_path();
+  const std::string input = (directory / "cpp_utils_trace_input.csv").string();
+  const std::string output = (directory / "cpp_utils_trace_output.csv").string();
+  {
+    TRACE_SCOPE("generate input");
+    std::ofstream file(input, std::ios::binary);
+    file << "Gmt time;Close\n";
+    for (int i = 0; i < 200'000; i++) {
+      int minute = (i * 7) % 200'000;
+      file << "0" << 1 + minute / 1440 % 9 << ".02.2013 " << minute / 60 % 24 / 10 << minute / 60 % 24 % 10 << ":"
+           << minute % 60 / 10 << minute % 10 << ":00.000;1,3611\n";
+    }
+  }
+  ExternalSortOptions options;
+  options.memory_budget = 4 << 20;
+  options.nb_threads = 2;
+  sort_csv_files_by_time({input}, output, CsvDialect(), options);
+
+  const std::string trace = (directory / "cpp_utils_trace.json").string();
+  size_t nb_events = write_trace(trace);
+  std::cout << "write_trace: " << nb_events << " events, " << std::filesystem::file_size(trace) << " bytes in "
+            << trace << " (open in chrome://tracing or ui.perfetto.dev)" << std::endl;
+
+  std::filesystem::remove(input);
+  std::filesystem::remove(output);
+  std::filesystem::remove(trace);
+  return 0;
+}
+
+// end
@@ -0,0 +1,101 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include "stopwatch.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+// Scoped tracing: TRACE_SCOPE("name") records the time spent in the
+// enclosing scope; write_trace exports the events as Chrome trace JSON
+// (chrome://tracing, https://ui.perfetto.dev). Building with
+// -DCPP_UTILS_NO_TRACE compiles TRACE_SCOPE out completely.
+#if defined(CPP_UTILS_NO_TRACE)
+#define TRACE_SCOPE(name) ((void)0)
+#else
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#endif
+
+struct TraceEvent {
+  const char *name; // string literal, not copied
+  uint64_t begin;   // ticks, see trace_ticks
+  uint64_t end;
+};
+
+// Ring buffer of the events of one thread: written by that thread only,
+// without lock; once full, the oldest events are overwritten
+class TraceBuffer {
+public:
+  static constexpr size_t capacity = 1 << 15;
+
+  explicit TraceBuffer(uint32_t tid) : tid(tid), events(new TraceEvent[capacity]) {}
+
+  void record(const char *name, uint64_t begin, uint64_t end)
+  {
+    uint64_t h = head.load(std::memory_order_relaxed);
+    events[h & (capacity - 1)] = {name, begin, end};
+    head.store(h + 1, std::memory_order_release);
+  }
+
+  const uint32_t tid;
+  std::string thread_name;
+  std::atomic<uint64_t> head{0}; // number of events recorded since the start
+  std::unique_ptr<TraceEvent[]> events;
+};
+
+TraceBuffer *register_trace_thread();
+void release_trace_thread(TraceBuffer *buffer);
+
+// Buffer of a thread, from its first event until it exits; then handed,
+// with its events, to the next thread that starts tracing
+struct TraceThread {
+  TraceBuffer *const buffer = register_trace_thread();
+  ~TraceThread() { release_trace_thread(buffer); }
+};
+
+// Buffer of the calling thread, registered on its first event
+inline TraceBuffer &trace_buffer()
+{
+  thread_local TraceThread thread;
+  return *thread.buffer;
+}
+
+// Unserialized TSC read when the stopwatch uses the TSC, else nanoseconds
+inline uint64_t trace_ticks()
+{
+#if defined(STOPWATCH_X86)
+  if (stopwatch_calibration().uses_tsc) {
+    return __rdtsc();
+  }
+#endif
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+
+class TraceScope {
+public:
+  explicit TraceScope(const char *name) : name(name), begin(trace_ticks()) {}
+  ~TraceScope() { trace_buffer().record(name, begin, trace_ticks()); }
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+  const char *name;
+  uint64_t begin;
+};
+
+void set_trace_thread_name(const std::string &name);
+size_t write_trace(const std::string &filename);
+void write_trace_at_exit(const std::string &filename);
+void clear_trace();
+void write_json_string(std::ostream &out, const std::string &s);
+int SHOW_trace(void);
+
+#endif // TRACE_HPP
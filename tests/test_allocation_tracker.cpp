@@ -0,0 +1,99 @@
+#include "allocation_tracker.hpp"
+#include "benchmark.hpp"
+#include "csv_reader.hpp"
+#include "dates_and_times.hpp"
+#include <catch_amalgamated.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("AllocationScope counts the allocations of the thread", "[allocation_tracker]")
+{
+  if (!allocation_tracking_available()) {
+    SKIP("optional/allocation_tracking.cpp not linked");
+  }
+
+  AllocationCounts counts = count_allocations([] {
+    std::vector<int> v(1000);
+    v.push_back(1); // reallocation
+  });
+  REQUIRE(counts.tracked);
+  REQUIRE(counts.allocations == 2);
+  REQUIRE(counts.deallocations == 2);
+  REQUIRE(counts.bytes >= 1000 * sizeof(int) + 1001 * sizeof(int));
+  REQUIRE(counts.peak_live_bytes >= 1000 * sizeof(int) + 1001 * sizeof(int));
+
+  // Nothing allocated
+  int sum = 0;
+  counts = count_allocations([&sum] {
+    for (int i = 0; i < 100; i++) {
+      sum += i;
+    }
+  });
+  REQUIRE(counts.allocations == 0);
+  REQUIRE(counts.peak_live_bytes == 0);
+
+  // Nested scopes, array and over-aligned forms
+  struct alignas(64) Line {
+    char bytes[64];
+  };
+  AllocationScope outer;
+  auto kept = std::make_unique<char[]>(10'000);
+  {
+    AllocationScope inner;
+    auto line = std::make_unique<Line>();
+    auto missing = std::unique_ptr<int>(new (std::nothrow) int(3));
+    REQUIRE(reinterpret_cast<uintptr_t>(line.get()) % 64 == 0);
+    REQUIRE(inner.counts().allocations == 2);
+    REQUIRE(inner.counts().peak_live_bytes < 10'000);
+  }
+  REQUIRE(outer.counts().allocations == 3);
+  REQUIRE(outer.counts().deallocations == 2);
+  REQUIRE(outer.counts().peak_live_bytes >= 10'000);
+
+  // Other threads are not counted
+  AllocationScope scope;
+  std::thread([] { std::vector<int> v(1000); }).join();
+  REQUIRE(scope.counts().allocations <= 1); // the thread's own state, at most
+
+  AllocationScope disabled(false);
+  std::string text(100, 'x');
+  REQUIRE_FALSE(disabled.counts().tracked);
+  REQUIRE(disabled.counts().allocations == 0);
+}
+
+TEST_CASE("Hot paths can be required not to allocate", "[allocation_tracker]")
+{
+  std::chrono::system_clock::time_point tp;
+  REQUIRE(count_allocations([&tp] { parse_timestamp("01.02.2013 00:00:00.000", TimestampLayout::DMY, tp); })
+              .allocations == 0);
+  if (!allocation_tracking_available()) {
+    SKIP("optional/allocation_tracking.cpp not linked");
+  }
+  std::string text;
+  REQUIRE(count_allocations([&] { text = format_date_time_UTC(tp); }).allocations > 0);
+
+  BenchmarkOptions options;
+  options.min_runs = 3;
+  options.max_runs = 3;
+  options.track_allocations = true;
+  BenchmarkResult result = benchmark([] { return std::make_unique<double>(1.0); }, options);
+  REQUIRE(result.allocations.tracked);
+  REQUIRE(result.allocations.allocations == 3);
+  REQUIRE(result.allocations.bytes == 3 * sizeof(double));
+
+  std::ostringstream out;
+  print_benchmark_result("make_unique", result, out);
+  REQUIRE(out.str().find("per run: 1.0 allocations, 8.0 bytes") != std::string::npos);
+
+  options.track_allocations = false;
+  result = benchmark([] { return std::make_unique<double>(1.0); }, options);
+  REQUIRE_FALSE(result.allocations.tracked);
+}
+
+// end
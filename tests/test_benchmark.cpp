@@ -0,0 +1,150 @@
+#include "benchmark.hpp"
+#include <catch_amalgamated.hpp>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("summarize_durations computes robust statistics", "[benchmark]")
+{
+  REQUIRE_THAT(percentile({1.0, 2.0, 3.0, 4.0}, 50.0), Catch::Matchers::WithinAbs(2.5, 1e-12));
+  REQUIRE_THAT(percentile({4.0, 1.0, 3.0, 2.0}, 0.0), Catch::Matchers::WithinAbs(1.0, 1e-12));
+  REQUIRE_THAT(percentile({4.0, 1.0, 3.0, 2.0}, 100.0), Catch::Matchers::WithinAbs(4.0, 1e-12));
+  REQUIRE_THAT(percentile({1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0}, 90.0),
+               Catch::Matchers::WithinAbs(10.0, 1e-12));
+  REQUIRE_THROWS_AS(percentile({}, 50.0), std::invalid_argument);
+
+  // One outlier: median and MAD are unaffected, mean and stddev are
+  BenchmarkResult result = summarize_durations({1.0, 1.1, 0.9, 1.0, 1.2, 0.8, 10.0});
+  REQUIRE(result.durations.size() == 7);
+  REQUIRE_THAT(result.min, Catch::Matchers::WithinAbs(0.8, 1e-12));
+  REQUIRE_THAT(result.max, Catch::Matchers::WithinAbs(10.0, 1e-12));
+  REQUIRE_THAT(result.median, Catch::Matchers::WithinAbs(1.0, 1e-12));
+  REQUIRE_THAT(result.mad, Catch::Matchers::WithinAbs(0.1, 1e-12));
+  REQUIRE_THAT(result.mean, Catch::Matchers::WithinAbs(16.0 / 7.0, 1e-12));
+  REQUIRE(result.stddev > 3.0);
+  REQUIRE_THAT(result.ci95, Catch::Matchers::WithinRel(2.447 * result.stddev / std::sqrt(7.0), 1e-9));
+
+  BenchmarkResult single = summarize_durations({2.0});
+  REQUIRE(single.median == 2.0);
+  REQUIRE(single.stddev == 0.0);
+  REQUIRE(single.ci95 == 0.0);
+  REQUIRE(summarize_durations({}).durations.empty());
+
+  std::ostringstream out;
+  print_benchmark_result("test", result, out);
+  REQUIRE(out.str().find("7 runs, median 1.000000 s") != std::string::npos);
+}
+
+TEST_CASE("benchmark runs warm-up and adaptive measured runs", "[benchmark]")
+{
+  int calls = 0;
+  BenchmarkOptions options;
+  options.warmup_runs = 2;
+  options.min_runs = 3;
+  options.max_runs = 7;
+  options.target_relative_ci = 0.0; // never precise enough: max_runs
+  BenchmarkResult result = benchmark([&calls] { calls++; }, options);
+  REQUIRE(calls == 9);
+  REQUIRE(result.durations.size() == 7);
+
+  // Self-timed callable: the returned duration is used
+  calls = 0;
+  result = benchmark(
+      [&calls] {
+        calls++;
+        return std::chrono::milliseconds(calls % 2 ? 10 : 30);
+      },
+      options);
+  REQUIRE(result.durations.size() == 7);
+  REQUIRE_THAT(result.min, Catch::Matchers::WithinAbs(0.010, 1e-12));
+  REQUIRE_THAT(result.max, Catch::Matchers::WithinAbs(0.030, 1e-12));
+
+  // Constant durations: precise after min_runs
+  options.target_relative_ci = 0.01;
+  result = benchmark([] { return std::chrono::microseconds(5); }, options);
+  REQUIRE(result.durations.size() == 3);
+
+  // Time limit
+  options.max_runs = 1000;
+  options.target_relative_ci = 0.0;
+  options.max_seconds = 1.0;
+  calls = 0;
+  result = benchmark([&calls] { return std::chrono::milliseconds(++calls % 2 ? 125 : 375); }, options);
+  REQUIRE(result.durations.size() == 4);
+
+  // Value-returning callable
+  std::vector<double> values(1000, 1.0);
+  result = benchmark(
+      [&values] {
+        double sum = 0.0;
+        for (double v : values) {
+          sum += v;
+        }
+        return sum;
+      },
+      options);
+  REQUIRE(result.min > 0.0);
+}
+
+TEST_CASE("find_outliers uses the modified z-score", "[benchmark]")
+{
+  REQUIRE(find_outliers({1.0, 1.1, 0.9, 1.0, 5.0}) == std::vector<size_t>{4});
+  REQUIRE(find_outliers({1.0, 1.1, 0.9, 1.0, 1.2}).empty());
+  REQUIRE(find_outliers({2.0, 2.0, 2.0, 2.0}).empty());
+  // MAD of 0: mean absolute deviation instead
+  REQUIRE(find_outliers({2.0, 2.0, 2.0, 2.0, 2.0, 9.0}) == std::vector<size_t>{5});
+  REQUIRE(find_outliers({1.0, 100.0}).empty()); // too few values
+  REQUIRE(find_outliers({1.0, 1.1, 0.9, 1.0, 1.5}, 2.0) == std::vector<size_t>{4});
+
+  BenchmarkResult result = summarize_durations({1.0, 1.1, 0.9, 1.0, 5.0});
+  REQUIRE(result.outliers == std::vector<size_t>{4});
+  REQUIRE_THAT(result.mean, Catch::Matchers::WithinAbs(1.8, 1e-12));
+  REQUIRE_THAT(result.adjusted_mean, Catch::Matchers::WithinAbs(1.0, 1e-12));
+  REQUIRE(result.adjusted_ci95 < result.ci95);
+
+  std::ostringstream out;
+  print_benchmark_result("noisy", result, out);
+  REQUIRE(out.str().find("without 1 outlier run(s)") != std::string::npos);
+}
+
+TEST_CASE("benchmark pins to a CPU and reports its environment", "[benchmark]")
+{
+#if defined(__linux__)
+  const int cpu = current_cpu();
+  REQUIRE(last_allowed_cpu() >= 0);
+  {
+    CpuPinning pinning(last_allowed_cpu());
+    REQUIRE(pinning.pinned());
+    REQUIRE(current_cpu() == last_allowed_cpu());
+  }
+  REQUIRE_FALSE(CpuPinning(-1).pinned());
+  REQUIRE_FALSE(CpuPinning(1 << 20).pinned());
+  REQUIRE(load_average() >= 0.0);
+  REQUIRE(cpu >= 0);
+#endif
+
+  BenchmarkOptions options;
+  options.min_runs = 3;
+  options.max_runs = 3;
+  options.pin_cpu = last_allowed_cpu();
+  options.check_environment = true;
+  BenchmarkResult result = benchmark([] { return std::chrono::microseconds(5); }, options);
+  REQUIRE(result.durations.size() == 3);
+#if defined(__linux__)
+  REQUIRE(result.pinned_cpu == last_allowed_cpu());
+  REQUIRE(result.nb_migrations == 0);
+  REQUIRE(result.load_average >= 0.0);
+#endif
+  for (const std::string &warning : result.warnings) {
+    REQUIRE_FALSE(warning.empty());
+  }
+
+  options.pin_cpu = 1 << 20;
+  options.check_environment = false;
+  result = benchmark([] { return std::chrono::microseconds(5); }, options);
+  REQUIRE(result.pinned_cpu == -1);
+  REQUIRE(result.warnings.size() == 1);
+}
+
+// end
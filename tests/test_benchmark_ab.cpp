@@ -0,0 +1,80 @@
+#include "benchmark_ab.hpp"
+#include <catch_amalgamated.hpp>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("bootstrap_ratio_interval and ab_verdict", "[benchmark_ab]")
+{
+  std::vector<double> a, b;
+  for (int i = 0; i < 30; i++) {
+    a.push_back(1.0 + 0.01 * (i % 7));
+    b.push_back(0.5 + 0.005 * ((i * 3) % 7));
+  }
+  auto [low, high] = bootstrap_ratio_interval(a, b);
+  REQUIRE(low <= high);
+  REQUIRE(low > 0.45);
+  REQUIRE(high < 0.55);
+  // Reproducible with the same seed
+  REQUIRE(bootstrap_ratio_interval(a, b) == std::make_pair(low, high));
+  // Unpaired (different sizes)
+  b.pop_back();
+  auto unpaired = bootstrap_ratio_interval(a, b, 0.9, 500, 1);
+  REQUIRE(unpaired.first > 0.45);
+  REQUIRE(unpaired.second < 0.55);
+  REQUIRE(bootstrap_ratio_interval({}, b) == std::make_pair(1.0, 1.0));
+
+  ABOptions options; // 95%, equivalence +/- 1%
+  REQUIRE(ab_verdict(0.80, 0.90, 0.001, options) == ABVerdict::B_FASTER);
+  REQUIRE(ab_verdict(1.10, 1.20, 0.001, options) == ABVerdict::B_SLOWER);
+  REQUIRE(ab_verdict(0.995, 1.005, 0.001, options) == ABVerdict::EQUIVALENT);
+  REQUIRE(ab_verdict(0.80, 0.90, 0.2, options) == ABVerdict::INCONCLUSIVE);  // not significant
+  REQUIRE(ab_verdict(0.90, 1.10, 0.001, options) == ABVerdict::INCONCLUSIVE); // interval across 1
+  REQUIRE(std::string(ab_verdict_name(ABVerdict::B_FASTER)) == "B is faster");
+}
+
+TEST_CASE("benchmark_ab interleaves the variants", "[benchmark_ab]")
+{
+  std::string order;
+  ABOptions options;
+  options.warmup_runs = 1;
+  options.min_pairs = 4;
+  options.max_pairs = 4;
+  benchmark_ab([&order] { order += 'A'; }, [&order] { order += 'B'; }, options);
+  REQUIRE(order == "AB" "AB" "BA" "AB" "BA");
+
+  // Self-timed variants: B takes 20% less time, with some noise
+  int calls_a = 0, calls_b = 0;
+  options.min_pairs = 10;
+  options.max_pairs = 100;
+  ABResult result = benchmark_ab([&calls_a] { return std::chrono::microseconds(1000 + 7 * (++calls_a % 5)); },
+                                 [&calls_b] { return std::chrono::microseconds(800 + 5 * (++calls_b % 3)); }, options);
+  REQUIRE(result.verdict == ABVerdict::B_FASTER);
+  REQUIRE(result.a.durations.size() == result.b.durations.size());
+  REQUIRE(result.a.durations.size() < 100); // precise enough before max_pairs
+  REQUIRE_THAT(result.ratio, Catch::Matchers::WithinAbs(0.8, 0.02));
+  REQUIRE(result.ratio_low <= result.ratio);
+  REQUIRE(result.ratio_high >= result.ratio);
+  REQUIRE(result.p_value < 0.001);
+
+  std::ostringstream out;
+  print_ab_result("v1", "v2", result, out);
+  REQUIRE(out.str().find("Verdict: B is faster") != std::string::npos);
+
+  // Same durations: no practical difference
+  calls_a = calls_b = 0;
+  result = benchmark_ab([&calls_a] { return std::chrono::microseconds(1000 + 3 * (++calls_a % 4)); },
+                        [&calls_b] { return std::chrono::microseconds(1000 + 3 * (++calls_b % 4)); }, options);
+  REQUIRE(result.verdict == ABVerdict::EQUIVALENT);
+
+  // Few noisy pairs: inconclusive
+  calls_a = calls_b = 0;
+  options.min_pairs = 4;
+  options.max_pairs = 4;
+  result = benchmark_ab([&calls_a] { return std::chrono::microseconds(++calls_a % 2 ? 500 : 1500); },
+                        [&calls_b] { return std::chrono::microseconds(++calls_b % 2 ? 1400 : 600); }, options);
+  REQUIRE(result.verdict == ABVerdict::INCONCLUSIVE);
+}
+
+// end
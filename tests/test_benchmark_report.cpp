@@ -0,0 +1,105 @@
+#include "benchmark_report.hpp"
+#include <catch_amalgamated.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+BenchmarkResult result_of(double base, double step, int n)
+{
+  std::vector<double> durations;
+  for (int i = 0; i < n; i++) {
+    durations.push_back(base + step * (i % 7));
+  }
+  return summarize_durations(durations);
+}
+
+} // namespace
+
+TEST_CASE("mann_whitney_p_value detects shifted samples", "[benchmark_report][benchmark]")
+{
+  std::vector<double> a = {1.0, 1.1, 1.2, 1.3, 1.4, 1.5, 1.6, 1.7, 1.8, 1.9};
+  std::vector<double> b = {2.0, 2.1, 2.2, 2.3, 2.4, 2.5, 2.6, 2.7, 2.8, 2.9};
+  REQUIRE(mann_whitney_p_value(a, b) < 0.001);
+  REQUIRE(mann_whitney_p_value(a, b) == mann_whitney_p_value(b, a));
+  REQUIRE(mann_whitney_p_value(a, a) > 0.9);
+  REQUIRE(mann_whitney_p_value({1.0, 1.0}, {1.0, 1.0, 1.0}) == 1.0);
+  REQUIRE(mann_whitney_p_value({}, a) == 1.0);
+  // Interleaved samples: not significant
+  std::vector<double> c = {1.05, 1.15, 1.25, 1.35, 1.45, 1.55, 1.65, 1.75, 1.85, 1.95};
+  REQUIRE(mann_whitney_p_value(a, c) > 0.5);
+}
+
+TEST_CASE("Benchmark results round-trip through JSON and compare", "[benchmark_report][benchmark]")
+{
+  BenchmarkReport baseline;
+  baseline.environment = current_benchmark_environment();
+  baseline.environment.cpu = "CPU \"quoted\", with comma";
+  REQUIRE(!baseline.environment.date.empty());
+  REQUIRE(baseline.environment.nb_cpus > 0);
+  REQUIRE(!baseline.environment.compiler_flags.empty());
+  baseline.records.push_back({"stable", result_of(1.0, 0.01, 20)});
+  baseline.records.push_back({"slower", result_of(1.0, 0.01, 20)});
+  baseline.records.push_back({"faster", result_of(1.0, 0.01, 20)});
+  baseline.records.push_back({"removed", result_of(1.0, 0.01, 20)});
+  baseline.records[0].result.items_per_run = 1000;
+
+  const std::filesystem::path directory = std::filesystem::temp_directory_path();
+  const std::string json = (directory / "cpp_utils_benchmark_report_test.json").string();
+  const std::string csv = (directory / "cpp_utils_benchmark_report_test.csv").string();
+  write_benchmark_json(baseline, json);
+  BenchmarkReport reloaded = read_benchmark_json(json);
+  REQUIRE(reloaded.environment.cpu == baseline.environment.cpu);
+  REQUIRE(reloaded.environment.git_revision == baseline.environment.git_revision);
+  REQUIRE(reloaded.environment.nb_cpus == baseline.environment.nb_cpus);
+  REQUIRE(reloaded.records.size() == 4);
+  REQUIRE(reloaded.records[0].name == "stable");
+  REQUIRE(reloaded.records[0].result.durations == baseline.records[0].result.durations);
+  REQUIRE(reloaded.records[0].result.median == baseline.records[0].result.median);
+  REQUIRE(reloaded.records[0].result.items_per_run == 1000);
+
+  write_benchmark_csv(baseline, csv);
+  std::ifstream file(csv);
+  std::string header, row;
+  std::getline(file, header);
+  std::getline(file, row);
+  REQUIRE(header.rfind("date,git_revision,host,cpu,compiler,compiler_flags,name,runs,median,", 0) == 0);
+  REQUIRE(row.find("\"CPU \"\"quoted\"\", with comma\"") != std::string::npos);
+  REQUIRE(row.find(",stable,20,1.030000000,") != std::string::npos);
+
+  BenchmarkReport candidate;
+  candidate.records.push_back({"stable", result_of(1.0, 0.01, 20)});
+  candidate.records.push_back({"slower", result_of(1.2, 0.01, 20)});
+  candidate.records.push_back({"faster", result_of(0.8, 0.01, 20)});
+  candidate.records.push_back({"added", result_of(1.0, 0.01, 20)});
+  std::vector<BenchmarkComparison> comparisons = compare_benchmarks(reloaded, candidate);
+  REQUIRE(comparisons.size() == 3);
+  REQUIRE(!comparisons[0].regression);
+  REQUIRE(!comparisons[0].improvement);
+  REQUIRE(comparisons[1].regression);
+  REQUIRE_THAT(comparisons[1].change, Catch::Matchers::WithinAbs(0.2 / 1.03, 1e-9));
+  REQUIRE(comparisons[2].improvement);
+  std::ostringstream out;
+  REQUIRE(print_benchmark_comparison(comparisons, out));
+  REQUIRE(out.str().find("slower: ") != std::string::npos);
+  REQUIRE(out.str().find("REGRESSION") != std::string::npos);
+
+  // A small slowdown, even significant, is below min_change
+  candidate.records[1].result = result_of(1.03, 0.01, 20);
+  REQUIRE(!compare_benchmarks(reloaded, candidate)[1].regression);
+  REQUIRE(compare_benchmarks(reloaded, candidate, 0.01)[1].regression);
+
+  {
+    std::ofstream bad(json);
+    bad << "{\"environment\": {}, \"benchmarks\": [1, 2";
+  }
+  REQUIRE_THROWS_AS(read_benchmark_json(json), std::runtime_error);
+  std::filesystem::remove(json);
+  std::filesystem::remove(csv);
+  REQUIRE_THROWS_AS(read_benchmark_json(json), std::runtime_error);
+}
+
+// end
@@ -0,0 +1,100 @@
+#include "benchmark_scaling.hpp"
+#include "parallelism_with_async.hpp"
+#include "parallelism_with_openmp.hpp"
+#include "parallelism_with_threads.hpp"
+#include <algorithm>
+#include <catch_amalgamated.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("Leibniz kernels compute pi with any thread count", "[benchmark_scaling]")
+{
+  const double pi = 3.14159265358979323846;
+  for (int nb_threads : {1, 3, 8}) {
+    REQUIRE_THAT(leibniz_pi_with_async(1'000'003, nb_threads), Catch::Matchers::WithinAbs(pi, 1e-5));
+    REQUIRE_THAT(leibniz_pi_with_openmp_reduction(1'000'003, nb_threads), Catch::Matchers::WithinAbs(pi, 1e-5));
+    REQUIRE_THAT(leibniz_pi_with_openmp_atomic(1'000'003, nb_threads), Catch::Matchers::WithinAbs(pi, 1e-5));
+    REQUIRE_THAT(leibniz_pi_with_threads(1'000'003, nb_threads), Catch::Matchers::WithinAbs(pi, 1e-5));
+  }
+}
+
+TEST_CASE("karp_flatt_metric", "[benchmark_scaling]")
+{
+  REQUIRE_THAT(karp_flatt_metric(4.0, 4), Catch::Matchers::WithinAbs(0.0, 1e-12));
+  REQUIRE_THAT(karp_flatt_metric(1.0, 4), Catch::Matchers::WithinAbs(1.0, 1e-12));
+  REQUIRE_THAT(karp_flatt_metric(3.2, 4), Catch::Matchers::WithinAbs(1.0 / 12.0, 1e-12));
+  REQUIRE(karp_flatt_metric(1.0, 1) == 0.0);
+}
+
+TEST_CASE("run_scaling_sweep covers the grid of registered kernels", "[benchmark_scaling]")
+{
+  register_scaling_kernel("sum", [](uint64_t n, int) {
+    double s = 0.0;
+    for (uint64_t i = 0; i < n; i++) {
+      s += static_cast<double>(i);
+    }
+    return s;
+  });
+  register_scaling_kernel("sum", [](uint64_t n, int) { return static_cast<double>(n); }); // replaces
+  std::vector<ScalingKernel> kernels = registered_scaling_kernels();
+  auto sum = std::find_if(kernels.begin(), kernels.end(), [](const ScalingKernel &k) { return k.name == "sum"; });
+  REQUIRE(sum != kernels.end());
+  REQUIRE(std::count_if(kernels.begin(), kernels.end(), [](const ScalingKernel &k) { return k.name == "sum"; }) == 1);
+  REQUIRE(sum->run(7, 1) == 7.0);
+
+  ScalingSweepOptions options;
+  options.sizes = {1000, 100'000};
+  options.thread_counts = {4, 2, 2, 0}; // 1 added, duplicates and 0 dropped
+  options.benchmark.min_runs = 3;
+  options.benchmark.max_runs = 3;
+  std::vector<ScalingPoint> points =
+      run_scaling_sweep({{"async", leibniz_pi_with_async}, {"threads", leibniz_pi_with_threads}}, options);
+  REQUIRE(points.size() == 2 * 2 * 3);
+  REQUIRE(points[0].kernel == "async");
+  REQUIRE(points[0].n == 1000);
+  REQUIRE(points[0].nb_threads == 1);
+  REQUIRE(points[2].nb_threads == 4);
+  REQUIRE(points[3].n == 100'000);
+  REQUIRE(points[6].kernel == "threads");
+  for (const ScalingPoint &p : points) {
+    REQUIRE(p.result.durations.size() == 3);
+    if (p.nb_threads == 1) {
+      REQUIRE(p.speedup == 1.0);
+      REQUIRE(p.karp_flatt == 0.0);
+    }
+    REQUIRE_THAT(p.efficiency, Catch::Matchers::WithinAbs(p.speedup / p.nb_threads, 1e-12));
+  }
+
+  std::ostringstream table;
+  print_scaling_table(points, table);
+  REQUIRE(table.str().find("Karp-Flatt") != std::string::npos);
+
+  const std::filesystem::path directory = std::filesystem::temp_directory_path();
+  const std::string csv = (directory / "cpp_utils_test_scaling.csv").string();
+  const std::string script = (directory / "cpp_utils_test_scaling.gp").string();
+  write_scaling_csv(points, csv);
+  write_scaling_gnuplot(points, script, "scaling.png");
+
+  std::ifstream csv_file(csv);
+  std::string line;
+  std::getline(csv_file, line);
+  REQUIRE(line == "kernel,n,threads,runs,median,mean,ci95,speedup,efficiency,karp_flatt");
+  std::getline(csv_file, line);
+  REQUIRE(line.rfind("async,1000,1,3,", 0) == 0);
+
+  std::ifstream script_file(script);
+  std::stringstream text;
+  text << script_file.rdbuf();
+  REQUIRE(text.str().find("$curve3 << EOD") != std::string::npos);
+  REQUIRE(text.str().find("$curve4") == std::string::npos);
+  REQUIRE(text.str().find("set output 'scaling.png'") != std::string::npos);
+  REQUIRE(text.str().find("title 'threads, n = 100000'") != std::string::npos);
+
+  std::filesystem::remove(csv);
+  std::filesystem::remove(script);
+}
+
+// end
@@ -0,0 +1,92 @@
+#include "columnar_dataset.hpp"
+#include "csv_reader.hpp"
+#include <catch_amalgamated.hpp>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+
+TEST_CASE("ColumnarDataset in local memory", "[columnar_dataset]")
+{
+  ColumnarDataset dataset({{"id", ColumnType::INT64}, {"price", ColumnType::DOUBLE}}, 100);
+  REQUIRE(dataset.nb_rows() == 100);
+  REQUIRE(dataset.nb_columns() == 2);
+  REQUIRE(dataset.column_name(1) == "price");
+  REQUIRE(dataset.column_type(0) == ColumnType::INT64);
+  REQUIRE(dataset.column_index("price") == 1);
+  REQUIRE_FALSE(dataset.is_shared());
+
+  double *price = dataset.mutable_column<double>(1);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(price) % 64 == 0);
+  REQUIRE(price[99] == 0.0);
+  price[99] = 1.5;
+  REQUIRE(dataset.column<double>(1)[99] == 1.5);
+
+  REQUIRE_THROWS_AS(dataset.column<double>(0), std::invalid_argument);
+  REQUIRE_THROWS_AS(dataset.mutable_column<double>(0), std::invalid_argument);
+  REQUIRE_THROWS_AS(dataset.column_index("volume"), std::invalid_argument);
+  REQUIRE_THROWS_AS(dataset.column_name(2), std::out_of_range);
+  REQUIRE_THROWS_AS(ColumnarDataset({{std::string(40, 'x'), ColumnType::DOUBLE}}, 1), std::invalid_argument);
+
+  ColumnarDataset moved = std::move(dataset);
+  REQUIRE(moved.column<double>(1)[99] == 1.5);
+}
+
+#if !defined(_WIN32)
+TEST_CASE("ColumnarDataset published in shared memory", "[columnar_dataset]")
+{
+  const std::string name = "/cpp_utils_test_dataset";
+  ColumnarDataset::remove_shared(name);
+  REQUIRE_THROWS_AS(ColumnarDataset::attach_shared(name), std::runtime_error);
+
+  SECTION("Create, seal, attach")
+  {
+    ColumnarDataset created = ColumnarDataset::create_shared(name, {{"x", ColumnType::DOUBLE}}, 1'000);
+    REQUIRE_THROWS_AS(ColumnarDataset::create_shared(name, {{"x", ColumnType::DOUBLE}}, 1), std::runtime_error);
+    REQUIRE_THROWS_AS(ColumnarDataset::attach_shared(name), std::runtime_error); // not sealed yet
+    for (int i = 0; i < 1'000; i++) {
+      created.mutable_column<double>(0)[i] = i;
+    }
+    created.seal();
+
+    ColumnarDataset attached = ColumnarDataset::attach_shared(name);
+    REQUIRE(attached.is_read_only());
+    REQUIRE(attached.nb_rows() == 1'000);
+    REQUIRE(attached.column_name(0) == "x");
+    REQUIRE(attached.column<double>(0)[999] == 999.0);
+    REQUIRE_THROWS_AS(attached.mutable_column<double>(0), std::logic_error);
+    created.mutable_column<double>(0)[0] = -1.0;
+    REQUIRE(attached.column<double>(0)[0] == -1.0); // same pages
+  }
+
+  SECTION("OHLCV loader, local and shared")
+  {
+    const std::string path = (std::filesystem::temp_directory_path() / "cpp_utils_dataset_test.csv").string();
+    {
+      std::ofstream out(path, std::ios::binary);
+      out << "Gmt time;Open;High;Low;Close;Volume\n"
+             "01.02.2013 00:00:00.000;1,36115;1,36118;1,36108;1,36108;37,95\n"
+             "01.02.2013 00:01:00.000;1,36107;1,36129;1,36107;1,36129;58,01\n";
+    }
+    const std::vector<OhlcvBar> bars = read_ohlcv_csv(path);
+    const ColumnarDataset local = load_ohlcv_dataset(path);
+    {
+      const ColumnarDataset published = load_ohlcv_dataset(path, name);
+    }
+    const ColumnarDataset attached = ColumnarDataset::attach_shared(name); // outlives the publisher
+    for (const ColumnarDataset *d : {&local, &attached}) {
+      REQUIRE(d->nb_rows() == 2);
+      REQUIRE(d->column<int64_t>(d->column_index("time_ms"))[1] ==
+              std::chrono::duration_cast<std::chrono::milliseconds>(bars[1].time.time_since_epoch()).count());
+      REQUIRE(d->column<double>(d->column_index("close"))[1] == bars[1].close);
+      REQUIRE(d->column<double>(d->column_index("volume"))[0] == bars[0].volume);
+    }
+    std::filesystem::remove(path);
+  }
+
+  REQUIRE(ColumnarDataset::remove_shared(name));
+  REQUIRE_FALSE(ColumnarDataset::remove_shared(name));
+}
+#endif
@@ -0,0 +1,117 @@
+#include "csv_external_sort.hpp"
+#include "csv_reader.hpp"
+#include "dates_and_times.hpp"
+#include <algorithm>
+#include <catch_amalgamated.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> read_lines(const std::string &filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(file, line)) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+} // namespace
+
+TEST_CASE("sort_csv_files_by_time merges runs into one stable sorted file", "[csv_external_sort][csv]")
+{
+  using namespace std::chrono;
+  const system_clock::time_point tp0 = parse_date_time_UTC("01.02.2013 00:00:00.000");
+  const std::filesystem::path directory = std::filesystem::temp_directory_path();
+
+  // Three files, out of order, with duplicated timestamps across and within files;
+  // the last field is a sequence number, in input order
+  std::vector<std::string> inputs;
+  std::vector<std::pair<system_clock::time_point, std::string>> expected;
+  int sequence = 0;
+  for (int f = 0; f < 3; f++) {
+    inputs.push_back((directory / ("cpp_utils_external_sort_test_" + std::to_string(f) + ".csv")).string());
+    std::ofstream out(inputs.back(), std::ios::binary);
+    out << (f == 1 ? "\xEF\xBB\xBF" : "") << "Gmt time;Close;Seq\r\n";
+    for (int i = 0; i < 4'000; i++) {
+      system_clock::time_point tp = tp0 + seconds((i * 37 + f * 11) % 1'500);
+      std::string row = format_date_time_UTC(tp) + ";1,3611;" + std::to_string(sequence++);
+      out << row << (i % 3 == 0 ? "\r\n" : "\n");
+      if (i == 2'000) {
+        out << "\n"; // blank line
+      }
+      expected.emplace_back(tp, row);
+    }
+  }
+  std::stable_sort(expected.begin(), expected.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+  const std::string output = (directory / "cpp_utils_external_sort_test_out.csv").string();
+  ExternalSortOptions options;
+  options.memory_budget = 64 << 10; // many runs
+  options.nb_threads = 2;
+  ExternalSortResult result = sort_csv_files_by_time(inputs, output, sniff_csv_file(inputs[0]), options);
+  REQUIRE(result.nb_rows == expected.size());
+  REQUIRE(result.nb_runs > 10);
+  REQUIRE(result.nb_merge_passes > 1); // 2 runs per pass with such a budget
+  // The buffers of the nb_threads + 1 runs in memory stay within the budget
+  REQUIRE(result.peak_run_bytes > 0);
+  REQUIRE(result.peak_run_bytes * 3 <= options.memory_budget);
+
+  std::vector<std::string> lines = read_lines(output);
+  REQUIRE(lines.size() == expected.size() + 1);
+  REQUIRE(lines[0] == "Gmt time;Close;Seq");
+  for (size_t i = 0; i < expected.size(); i++) {
+    REQUIRE(lines[i + 1] == expected[i].second);
+  }
+
+  SECTION("A single run, and a single thread")
+  {
+    options.memory_budget = 64 << 20;
+    options.nb_threads = 1;
+    result = sort_csv_files_by_time(inputs, output, sniff_csv_file(inputs[0]), options);
+    REQUIRE(result.nb_runs == 1);
+    REQUIRE(result.nb_merge_passes == 1);
+    REQUIRE(read_lines(output) == lines);
+  }
+
+  SECTION("No data rows")
+  {
+    {
+      std::ofstream out(inputs[0], std::ios::binary);
+      out << "Gmt time;Close;Seq\n";
+    }
+    result = sort_csv_files_by_time({inputs[0]}, output, CsvDialect(), options);
+    REQUIRE(result.nb_rows == 0);
+    REQUIRE(result.nb_runs == 0);
+    REQUIRE(read_lines(output) == std::vector<std::string>{"Gmt time;Close;Seq"});
+  }
+
+  SECTION("Invalid timestamp")
+  {
+    {
+      std::ofstream out(inputs[2], std::ios::app);
+      out << "yesterday;1,3611;0\n";
+    }
+    REQUIRE_THROWS_AS(sort_csv_files_by_time(inputs, output, CsvDialect(), options), std::runtime_error);
+  }
+
+  for (const std::string &input : inputs) {
+    std::filesystem::remove(input);
+  }
+  std::filesystem::remove(output);
+  REQUIRE_THROWS_AS(sort_csv_files_by_time(inputs, output, CsvDialect(), options), std::runtime_error);
+
+  // No run file left behind
+  for (const auto &entry : std::filesystem::directory_iterator(directory)) {
+    REQUIRE(entry.path().filename().string().rfind("cpp_utils_sort_", 0) == std::string::npos);
+  }
+}
+
+// end
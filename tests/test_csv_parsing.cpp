@@ -0,0 +1,105 @@
+#include "csv_parsing.hpp"
+#include <catch_amalgamated.hpp>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// Random CSV with quoted fields containing delimiters, newlines and escaped quotes
+std::string make_tricky_csv(unsigned seed, int nb_rows)
+{
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> pick(0, 9);
+  std::string text;
+  for (int r = 0; r < nb_rows; r++) {
+    for (int f = 0; f < 4; f++) {
+      if (f > 0) {
+        text += ';';
+      }
+      switch (pick(gen)) {
+      case 0:
+        text += "\"a;b\nc\"";
+        break;
+      case 1:
+        text += "\"say \"\"hi\"\"\"";
+        break;
+      case 2:
+        text += "\"\"";
+        break;
+      case 3:
+        text += "\"\r\n\"";
+        break;
+      case 4:
+        break;
+      default:
+        text += "1,3612" + std::to_string(r % 10);
+      }
+    }
+    text += (pick(gen) < 3) ? "\r\n" : "\n";
+    if (pick(gen) == 0) {
+      text += "\n";
+    }
+  }
+  return text;
+}
+
+} // namespace
+
+TEST_CASE("parse_csv handles quotes, delimiters and newlines", "[parse_csv][csv]")
+{
+  SECTION("Simple records")
+  {
+    REQUIRE(parse_csv("a;b\n1;2\n", ';') == CsvTable{{"a", "b"}, {"1", "2"}});
+    REQUIRE(parse_csv("a,b\r\n1,2", ',') == CsvTable{{"a", "b"}, {"1", "2"}});
+  }
+
+  SECTION("Quoted fields")
+  {
+    REQUIRE(parse_csv("a;\"b;c\"\n1;\"x\"\"y\"\n", ';') == CsvTable{{"a", "b;c"}, {"1", "x\"y"}});
+    REQUIRE(parse_csv("\"multi\nline\";2\n", ';') == CsvTable{{"multi\nline", "2"}});
+    REQUIRE(parse_csv("\"\"\n", ';') == CsvTable{{""}});
+  }
+
+  SECTION("Blank records are skipped, empty fields are kept")
+  {
+    REQUIRE(parse_csv("\n\r\na;;\n\n", ';') == CsvTable{{"a", "", ""}});
+    REQUIRE(parse_csv("", ';').empty());
+  }
+}
+
+TEST_CASE("find_csv_record_boundaries finds real record starts", "[parse_csv_parallel][csv]")
+{
+  for (unsigned seed = 1; seed <= 5; seed++) {
+    const std::string text = make_tricky_csv(seed, 300);
+    const CsvTable expected = parse_csv(text, ';');
+
+    for (size_t nb_chunks : {1, 2, 3, 7, 16, 64, 1000}) {
+      std::vector<size_t> boundaries = find_csv_record_boundaries(text, nb_chunks);
+      REQUIRE(boundaries.size() == nb_chunks + 1);
+      REQUIRE(boundaries.front() == 0);
+      REQUIRE(boundaries.back() == text.size());
+
+      CsvTable concatenated;
+      for (size_t k = 0; k < nb_chunks; k++) {
+        REQUIRE(boundaries[k] <= boundaries[k + 1]);
+        CsvTable part = parse_csv(std::string_view(text).substr(boundaries[k], boundaries[k + 1] - boundaries[k]), ';');
+        concatenated.insert(concatenated.end(), part.begin(), part.end());
+      }
+      REQUIRE(concatenated == expected);
+    }
+  }
+}
+
+TEST_CASE("parse_csv_parallel matches parse_csv", "[parse_csv_parallel][csv]")
+{
+  const std::string text = make_tricky_csv(42, 20000);
+  const CsvTable expected = parse_csv(text, ';');
+  for (int nb_threads : {1, 2, 5, 8}) {
+    REQUIRE(parse_csv_parallel(text, ';', nb_threads) == expected);
+  }
+  REQUIRE(parse_csv_parallel("", ';').empty());
+}
+
+// end
@@ -0,0 +1,272 @@
+#include "csv_reader.hpp"
+#include "dates_and_times.hpp"
+#include "doubles.hpp"
+#include <catch_amalgamated.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+void write_file(const std::string &path, const std::string &content)
+{
+  std::ofstream out(path, std::ios::binary);
+  out << content;
+}
+
+} // namespace
+
+TEST_CASE("parse_timestamp handles each layout", "[csv_reader][csv]")
+{
+  using namespace std::chrono;
+  const system_clock::time_point expected = parse_date_time_UTC("01.02.2013 00:00:01.123");
+  system_clock::time_point tp;
+
+  REQUIRE(parse_timestamp("01.02.2013 00:00:01.123", TimestampLayout::DMY, tp));
+  REQUIRE(tp == expected);
+  REQUIRE(parse_timestamp("1.2.2013 0:0:1.123", TimestampLayout::DMY, tp)); // not fixed-width
+  REQUIRE(tp == expected);
+  REQUIRE(parse_timestamp("2013-02-01T00:00:01.123Z", TimestampLayout::ISO, tp));
+  REQUIRE(tp == expected);
+  REQUIRE(parse_timestamp("2013-02-01 00:00:01", TimestampLayout::ISO, tp));
+  REQUIRE(tp == expected - milliseconds(123));
+  REQUIRE(parse_timestamp("1359676801", TimestampLayout::EPOCH_SECONDS, tp));
+  REQUIRE(tp == expected - milliseconds(123));
+  REQUIRE(parse_timestamp("1359676801123", TimestampLayout::EPOCH_MILLISECONDS, tp));
+  REQUIRE(tp == expected);
+  REQUIRE(parse_timestamp("2013-02-01 00:00:01.123", TimestampLayout::UNKNOWN, tp));
+  REQUIRE(tp == expected);
+
+  REQUIRE_FALSE(parse_timestamp("Gmt time", TimestampLayout::DMY, tp));
+  REQUIRE_FALSE(parse_timestamp("2013-13-01 00:00:00", TimestampLayout::ISO, tp));
+  REQUIRE_FALSE(parse_timestamp("01.02.2013 00:00:01", TimestampLayout::ISO, tp));
+  REQUIRE_FALSE(parse_timestamp("12a", TimestampLayout::EPOCH_SECONDS, tp));
+}
+
+TEST_CASE("sniff_csv_dialect infers the dialect", "[csv_reader][csv]")
+{
+  SECTION("Semicolon, decimal comma, header")
+  {
+    CsvDialect d = sniff_csv_dialect("Gmt time;Open;High;Low;Close;Volume\n"
+                                     "01.02.2013 00:00:00.000;1,36115;1,36118;1,36108;1,36108;37,95\n"
+                                     "01.02.2013 00:01:00.000;1,36107;1,36129;1,36107;1,36129;58,01\n"
+                                     "01.02.2013 00:02:00.0");
+    REQUIRE(d.delimiter == ';');
+    REQUIRE(d.decimal_separator == ',');
+    REQUIRE(d.has_header);
+    REQUIRE_FALSE(d.quoted);
+    REQUIRE(d.timestamp_layout == TimestampLayout::DMY);
+  }
+
+  SECTION("Comma, decimal point, ISO, no header")
+  {
+    CsvDialect d = sniff_csv_dialect("2013-02-01T00:00:00Z,1.36115,1.36118,1.36108,1.36108,37\r\n"
+                                     "2013-02-01T00:01:00Z,1.36107,1.36129,1.36107,1.36129,58\r\n");
+    REQUIRE(d.delimiter == ',');
+    REQUIRE(d.decimal_separator == '.');
+    REQUIRE_FALSE(d.has_header);
+    REQUIRE(d.timestamp_layout == TimestampLayout::ISO);
+  }
+
+  SECTION("Tab, quoted fields, epoch milliseconds")
+  {
+    CsvDialect d = sniff_csv_dialect("\"time\"\t\"open\"\t\"high\"\t\"low\"\t\"close\"\n"
+                                     "\"1359676800000\"\t\"1,5\"\t\"1,6\"\t\"1,4\"\t\"1,5\"\n");
+    REQUIRE(d.delimiter == '\t');
+    REQUIRE(d.decimal_separator == ',');
+    REQUIRE(d.quoted);
+    REQUIRE(d.has_header);
+    REQUIRE(d.timestamp_layout == TimestampLayout::EPOCH_MILLISECONDS);
+  }
+}
+
+TEST_CASE("read_ohlcv_csv matches the generic parsers", "[csv_reader][csv]")
+{
+  const std::string path = (std::filesystem::temp_directory_path() / "cpp_utils_csv_reader.csv").string();
+
+  SECTION("Sniffed semicolon dialect")
+  {
+    write_file(path, "Gmt time;Open;High;Low;Close;Volume\r\n"
+                     "01.02.2013 00:00:00.000;1,36115;1,36118;1,36108;1,36108;37,95\r\n"
+                     "\r\n"
+                     "01.02.2013 00:01:00.000;1,36107;1,36129;1,36107;1,36129;58,01\r\n");
+    std::vector<OhlcvBar> bars = read_ohlcv_csv(path);
+    REQUIRE(bars.size() == 2);
+    REQUIRE(bars[0].time == parse_date_time_UTC("01.02.2013 00:00:00.000"));
+    REQUIRE(bars[0].open == parse_double("1,36115", ','));
+    REQUIRE(bars[0].volume == parse_double("37,95", ','));
+    REQUIRE(bars[1].time == parse_date_time_UTC("01.02.2013 00:01:00.000"));
+    REQUIRE(bars[1].close == parse_double("1,36129", ','));
+  }
+
+  SECTION("Quoted comma dialect without volume")
+  {
+    write_file(path, "\"2013-02-01 00:00:00\",\"1.5\",\"1.75\",\"1.25\",\"-1.5e-3\"\n");
+    std::vector<OhlcvBar> bars = read_ohlcv_csv(path);
+    REQUIRE(bars.size() == 1);
+    REQUIRE(bars[0].time == parse_date_time_UTC("01.02.2013 00:00:00"));
+    REQUIRE(bars[0].high == 1.75);
+    REQUIRE(bars[0].close == -1.5e-3);
+    REQUIRE(bars[0].volume == 0.0);
+  }
+
+  SECTION("Errors")
+  {
+    const CsvDialect dialect{';', ',', false, false, TimestampLayout::DMY};
+    write_file(path, "01.02.2013 00:00:00;1,5;1,6\n");
+    REQUIRE_THROWS_AS(read_ohlcv_csv(path, dialect), std::runtime_error);
+    write_file(path, "01.02.2013 00:00:00;1,5;x;1,4;1,5\n");
+    REQUIRE_THROWS_AS(read_ohlcv_csv(path, dialect), std::invalid_argument);
+    write_file(path, "2013-02-01 00:00:00;1,5;1,6;1,4;1,5\n");
+    REQUIRE_THROWS_AS(read_ohlcv_csv(path, dialect), std::runtime_error);
+    REQUIRE_THROWS_AS(read_ohlcv_csv(path + ".missing"), std::runtime_error);
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("read_ohlcv_csv with a time range matches filtering", "[csv_reader][csv]")
+{
+  using namespace std::chrono;
+  const std::string path = (std::filesystem::temp_directory_path() / "cpp_utils_csv_reader_range.csv").string();
+
+  // Large enough to span several 1 MB blocks
+  const system_clock::time_point tp0 = parse_date_time_UTC("01.02.2013 00:00:00.000");
+  std::string content = "Gmt time;Open;High;Low;Close;Volume\n";
+  for (int i = 0; i < 60'000; i++) {
+    std::string stamp = format_date_time_UTC(tp0 + minutes(i));
+    content += stamp + ";1,5;1,6;1,4;1," + std::to_string(i) + ";10\n";
+  }
+  write_file(path, content);
+
+  const CsvDialect dialect = sniff_csv_file(path);
+  const std::vector<OhlcvBar> all = read_ohlcv_csv(path, dialect);
+  REQUIRE(all.size() == 60'000);
+
+  auto filter = [&](const TimeRange &range) {
+    std::vector<OhlcvBar> result;
+    for (const OhlcvBar &bar : all) {
+      if (bar.time >= range.from && bar.time < range.to) {
+        result.push_back(bar);
+      }
+    }
+    return result;
+  };
+  auto same = [](const std::vector<OhlcvBar> &a, const std::vector<OhlcvBar> &b) {
+    if (a.size() != b.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+      if (a[i].time != b[i].time || a[i].close != b[i].close) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  const TimeRange ranges[] = {
+      {tp0 + minutes(30'000), tp0 + minutes(30'500)}, // middle
+      {tp0 - hours(1), tp0 + minutes(10)},            // start
+      {tp0 + minutes(59'990), tp0 + hours(10'000)},   // end
+      {tp0 + hours(10'000), tp0 + hours(20'000)},     // after the data
+      {tp0, tp0},                                     // empty
+  };
+  for (const TimeRange &range : ranges) {
+    REQUIRE(same(read_ohlcv_csv(path, dialect, range), filter(range)));
+  }
+  REQUIRE(read_ohlcv_csv(path, ranges[0]).size() == 500);
+
+  SECTION("Unsorted data")
+  {
+    write_file(path, "Gmt time;Open;High;Low;Close\n"
+                     "01.02.2013 00:05:00;1;1;1;1\n"
+                     "01.02.2013 00:01:00;2;2;2;2\n"
+                     "01.02.2013 00:02:00;3;3;3;3\n");
+    TimeRange range{tp0, tp0 + minutes(3), false};
+    REQUIRE(read_ohlcv_csv(path, dialect, range).size() == 2);
+    range.sorted = true; // stops at the first row past the range
+    REQUIRE(read_ohlcv_csv(path, dialect, range).empty());
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("read_ohlcv_columns reads only the projected columns", "[csv_reader][csv]")
+{
+  const std::string path = (std::filesystem::temp_directory_path() / "cpp_utils_csv_reader_columns.csv").string();
+  write_file(path, "Gmt time;Open;High;Low;Close;Volume\n"
+                   "01.02.2013 00:00:00.000;1,36115;1,36118;1,36108;1,36108;37,95\n"
+                   "01.02.2013 00:01:00.000;1,36107;1,36129;1,36107;1,36129;58,01\n");
+  const std::vector<OhlcvBar> bars = read_ohlcv_csv(path);
+
+  OhlcvColumns c = read_ohlcv_columns(path, OHLCV_TIME | OHLCV_CLOSE);
+  REQUIRE(c.time.size() == 2);
+  REQUIRE(c.close.size() == 2);
+  REQUIRE(c.open.empty());
+  REQUIRE(c.high.empty());
+  REQUIRE(c.low.empty());
+  REQUIRE(c.volume.empty());
+  for (size_t i = 0; i < bars.size(); i++) {
+    REQUIRE(c.time[i] == bars[i].time);
+    REQUIRE(c.close[i] == bars[i].close);
+  }
+
+  c = read_ohlcv_columns(path, OHLCV_ALL);
+  for (size_t i = 0; i < bars.size(); i++) {
+    REQUIRE(c.open[i] == bars[i].open);
+    REQUIRE(c.high[i] == bars[i].high);
+    REQUIRE(c.low[i] == bars[i].low);
+    REQUIRE(c.volume[i] == bars[i].volume);
+  }
+
+  c = read_ohlcv_columns(path, OHLCV_HIGH);
+  REQUIRE(c.time.empty());
+  REQUIRE(c.high.size() == 2);
+  REQUIRE(c.high[1] == bars[1].high);
+
+  SECTION("Skipped fields are not converted")
+  {
+    const CsvDialect dialect{';', ',', false, false, TimestampLayout::DMY};
+    write_file(path, "01.02.2013 00:00:00;x;x;x;1,5;x\n"
+                     "01.02.2013 00:01:00;x;x;x;2,5\n");
+    c = read_ohlcv_columns(path, dialect, OHLCV_TIME | OHLCV_CLOSE);
+    REQUIRE(c.close == std::vector<double>{1.5, 2.5});
+    REQUIRE_THROWS_AS(read_ohlcv_columns(path, dialect, OHLCV_OPEN), std::invalid_argument);
+    REQUIRE_THROWS_AS(read_ohlcv_columns(path, dialect, OHLCV_VOLUME), std::invalid_argument);
+
+    write_file(path, "01.02.2013 00:00:00;x;x;x;1,5;7\n"
+                     "01.02.2013 00:01:00;x;x;x;2,5\n");
+    c = read_ohlcv_columns(path, dialect, OHLCV_CLOSE | OHLCV_VOLUME);
+    REQUIRE(c.volume == std::vector<double>{7.0, 0.0}); // volume is optional
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("read_ohlcv_segmented matches read_ohlcv_columns", "[csv_reader][csv]")
+{
+  const std::string path = (std::filesystem::temp_directory_path() / "cpp_utils_csv_reader_segmented.csv").string();
+
+  // Several 1 MB read blocks and several column blocks
+  std::string content = "Gmt time;Open;High;Low;Close;Volume\n";
+  for (int i = 0; i < 40'000; i++) {
+    content += "01.02.2013 00:00:00.000;1,5;1,6;1,4;1," + std::to_string(i) + ";" + std::to_string(i % 7) + "\n";
+  }
+  write_file(path, content);
+
+  const OhlcvColumns expected = read_ohlcv_columns(path, OHLCV_ALL);
+  const OhlcvSegmentedColumns segmented = read_ohlcv_segmented(path);
+  REQUIRE(segmented.close.size() == 40'000);
+  REQUIRE(segmented.close.nb_blocks() > 1);
+  REQUIRE(segmented.time.flatten() == expected.time);
+  REQUIRE(segmented.open.flatten() == expected.open);
+  REQUIRE(segmented.close.flatten() == expected.close);
+  REQUIRE(segmented.volume.flatten() == expected.volume);
+
+  const OhlcvSegmentedColumns closes = read_ohlcv_segmented(path, sniff_csv_file(path), OHLCV_CLOSE);
+  REQUIRE(closes.time.empty());
+  REQUIRE(closes.close.flatten() == expected.close);
+
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,68 @@
+#include "csv_parsing.hpp"
+#include "csv_time_search.hpp"
+#include "dates_and_times.hpp"
+#include "files_memory_map.hpp"
+#include <catch_amalgamated.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+TEST_CASE("find_first_row_at_or_after bisects sorted CSV text", "[csv_time_search][csv]")
+{
+  using namespace std::chrono;
+  const system_clock::time_point tp0 = parse_date_time_UTC("01.02.2013 00:00:00.000");
+
+  std::string text = "Gmt time;Close\n";
+  std::vector<size_t> offsets;
+  for (int i = 0; i < 5'000; i++) {
+    if (i % 700 == 0) {
+      text += "\r\n"; // blank lines
+    }
+    offsets.push_back(text.size());
+    // duplicates: two rows per minute, with varying line lengths
+    text += format_date_time_UTC(tp0 + minutes(i / 2)) + ";" + std::string(1 + i % 17, '1') + "\n";
+  }
+
+  REQUIRE(find_first_row_at_or_after(text, tp0 - hours(1)) == offsets[0]);
+  REQUIRE(find_first_row_at_or_after(text, tp0) == offsets[0]);
+  REQUIRE(find_first_row_at_or_after(text, tp0 + minutes(2'500)) == text.size());
+  for (int m : {1, 349, 350, 351, 1'234, 2'499}) {
+    REQUIRE(find_first_row_at_or_after(text, tp0 + minutes(m)) == offsets[2 * m]);
+    REQUIRE(find_first_row_at_or_after(text, tp0 + minutes(m) - milliseconds(1)) == offsets[2 * m]);
+  }
+
+  REQUIRE(find_first_row_at_or_after("", tp0) == 0);
+  REQUIRE(find_first_row_at_or_after("Gmt time;Close\n", tp0) == 15);
+
+  SECTION("Rows between, on a memory-mapped file")
+  {
+    const std::string path = (std::filesystem::temp_directory_path() / "cpp_utils_time_search_test.csv").string();
+    {
+      std::ofstream out(path, std::ios::binary);
+      out << text;
+    }
+    {
+      MemoryMappedFile file(path);
+      REQUIRE(file.size() == text.size());
+      file.advise(AccessPattern::RANDOM);
+      std::string_view rows = find_rows_between(file.view(), {tp0 + minutes(100), tp0 + minutes(110)});
+      CsvTable table = parse_csv(rows, ';');
+      REQUIRE(table.size() == 20);
+      REQUIRE(parse_date_time_UTC(table.front()[0]) == tp0 + minutes(100));
+      REQUIRE(parse_date_time_UTC(table.back()[0]) == tp0 + minutes(109));
+      REQUIRE(find_rows_between(file.view(), {tp0 + minutes(10), tp0}).empty());
+      REQUIRE_THROWS_AS(find_rows_between(file.view(), {tp0, tp0 + minutes(1), false}), std::invalid_argument);
+    }
+    std::filesystem::remove(path);
+    REQUIRE_THROWS_AS(MemoryMappedFile(path), std::runtime_error);
+  }
+
+  SECTION("ISO layout without header")
+  {
+    CsvDialect dialect{',', '.', false, false, TimestampLayout::ISO};
+    std::string iso = "2013-02-01T00:00:00Z,1\n2013-02-01T00:01:00Z,2\n2013-02-01T00:02:00Z,3";
+    REQUIRE(find_first_row_at_or_after(iso, tp0 + seconds(30), dialect) == 23);
+    REQUIRE(find_first_row_at_or_after(iso, tp0 + minutes(2), dialect) == 46);
+  }
+}
@@ -0,0 +1,109 @@
+#include "csv_parsing.hpp"
+#include "csv_writer.hpp"
+#include "dates_and_times.hpp"
+#include <catch_amalgamated.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+std::string read_file(const std::string &path)
+{
+  std::ifstream in(path, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+TEST_CASE("CsvWriter formats rows", "[csv_writer][csv]")
+{
+  const std::string path = (std::filesystem::temp_directory_path() / "cpp_utils_csv_writer.csv").string();
+
+  SECTION("Numbers with decimal separator")
+  {
+    {
+      CsvWriter writer(path, ';', ',');
+      writer.field(1.36115, 5).field(-29059.0996, 2).field(0.5, 0).field(42LL).field(-7LL).field(1e-7, 3);
+      writer.end_row();
+    }
+    REQUIRE(read_file(path) == "1,36115;-29059,10;0;42;-7;0,000\n");
+
+    {
+      CsvWriter writer(path, ',', '.');
+      writer.field(1.36115, 5).field(3.0, 1);
+      writer.end_row();
+    }
+    REQUIRE(read_file(path) == "1.36115,3.0\n");
+  }
+
+  SECTION("Timestamps in the format of parse_date_time_UTC")
+  {
+    using clock = std::chrono::system_clock;
+    {
+      CsvWriter writer(path);
+      writer.field(clock::time_point{}).end_row();
+      writer.field(parse_date_time_UTC("01.02.2013 00:00:00.123")).end_row();
+      writer.field(parse_date_time_UTC("29.02.2024 23:59:59.999"), false).end_row();
+      writer.field(clock::time_point{} - std::chrono::milliseconds(1)).end_row();
+    }
+    REQUIRE(read_file(path) ==
+            "01.01.1970 00:00:00.000\n"
+            "01.02.2013 00:00:00.123\n"
+            "29.02.2024 23:59:59\n"
+            "31.12.1969 23:59:59.999\n");
+
+    // Years beyond 9999 are rejected before the delimiter is written (when
+    // the clock reaches them: not with nanosecond ticks)
+    const std::chrono::hours year_10000(24LL * 3652425 * 8031 / 10000); // 8031 Gregorian years after 1970
+    if (std::chrono::duration<double>(clock::duration::max()) > year_10000) {
+      {
+        CsvWriter writer(path);
+        writer.field("before");
+        REQUIRE_THROWS_AS(writer.field(clock::time_point(std::chrono::duration_cast<clock::duration>(year_10000))),
+                          std::out_of_range);
+        writer.field("after").end_row();
+      }
+      REQUIRE(read_file(path) == "before;after\n");
+    }
+  }
+
+  SECTION("Text fields are quoted when needed and read back by parse_csv")
+  {
+    {
+      CsvWriter writer(path, ';');
+      writer.field("plain").field("a;b").field("say \"hi\"").field("multi\nline").field("");
+      writer.end_row();
+    }
+    REQUIRE(read_file(path) == "plain;\"a;b\";\"say \"\"hi\"\"\";\"multi\nline\";\n");
+    REQUIRE(parse_csv(read_file(path), ';') == CsvTable{{"plain", "a;b", "say \"hi\"", "multi\nline", ""}});
+  }
+
+  SECTION("Large outputs are flushed in several writes")
+  {
+    std::string expected;
+    {
+      CsvWriter writer(path, ';', ',', 64);
+      for (int i = 0; i < 1000; i++) {
+        writer.field(static_cast<long long>(i)).field(std::string(i % 100, 'x'));
+        writer.end_row();
+        expected += std::to_string(i) + ";" + std::string(i % 100, 'x') + "\n";
+      }
+      writer.flush();
+      REQUIRE(writer.bytes_written() == expected.size());
+    }
+    REQUIRE(read_file(path) == expected);
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("CsvWriter rejects unwritable files", "[csv_writer][csv]")
+{
+  REQUIRE_THROWS_AS(CsvWriter("/nonexistent/cpp_utils.csv"), std::runtime_error);
+}
+
+// end
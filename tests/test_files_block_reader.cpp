@@ -0,0 +1,152 @@
+#include "files.hpp"
+#include "files_block_reader.hpp"
+#include <catch_amalgamated.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string write_temp_file(const std::string &name, const std::string &content)
+{
+  std::string path = (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream out(path, std::ios::binary);
+  out << content;
+  return path;
+}
+
+std::string make_content(size_t nb_lines)
+{
+  std::string content = "Gmt time,Open,High,Low,Close,Volume\n";
+  for (size_t i = 0; i < nb_lines; i++) {
+    content += "01.02.2013 00:00:" + std::to_string(i % 60) + ".000,1.36115,1.36125,1.36110,1.36120,12.5\n";
+    if (i % 7 == 0) {
+      content += "\n";
+    }
+  }
+  return content;
+}
+
+} // namespace
+
+TEST_CASE("read_file_by_blocks delivers the whole file in order", "[read_file_by_blocks][files]")
+{
+  const std::string content = make_content(500);
+  const std::string path = write_temp_file("cpp_utils_block_reader.csv", content);
+
+  for (bool use_io_uring : {true, false}) {
+    for (size_t block_size : {size_t(1), size_t(7), size_t(4096), size_t(1) << 20}) {
+      BlockReaderOptions options;
+      options.block_size = block_size;
+      options.use_io_uring = use_io_uring;
+
+      std::string copy;
+      uint64_t expected_offset = 0;
+      bool in_order = true;
+      read_file_by_blocks(path, [&](const char *data, size_t size, uint64_t offset) {
+        in_order = in_order && (offset == expected_offset) && (size <= block_size);
+        expected_offset += size;
+        copy.append(data, size);
+      }, options);
+
+      REQUIRE(in_order);
+      REQUIRE(copy == content);
+    }
+  }
+
+  SECTION("Pread thread backend can be forced")
+  {
+    BlockReaderOptions options;
+    options.use_io_uring = false;
+    REQUIRE(read_file_by_blocks(path, [](const char *, size_t, uint64_t) {}, options) == "pread thread");
+  }
+
+  SECTION("Exceptions thrown by the callback are propagated")
+  {
+    BlockReaderOptions options;
+    options.block_size = 16;
+    for (bool use_io_uring : {true, false}) {
+      options.use_io_uring = use_io_uring;
+      REQUIRE_THROWS_AS(read_file_by_blocks(path, [](const char *, size_t, uint64_t) { throw std::logic_error("stop"); }, options),
+                        std::logic_error);
+    }
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("read_file_by_blocks rejects missing files", "[read_file_by_blocks][files]")
+{
+  REQUIRE_THROWS_AS(read_file_by_blocks("/nonexistent/cpp_utils.csv", [](const char *, size_t, uint64_t) {}),
+                    std::runtime_error);
+}
+
+TEST_CASE("count_lines_async matches count_lines", "[count_lines_async][files]")
+{
+  const std::string contents[] = {
+      "",
+      "\n",
+      "a",
+      "a\n",
+      "a\n\n\nb",
+      "header\r\nrow\r\n\r\n",
+      make_content(10000)};
+
+  int i = 0;
+  for (const std::string &content : contents) {
+    const std::string path = write_temp_file("cpp_utils_count_lines_" + std::to_string(i++) + ".csv", content);
+    REQUIRE(count_lines_async(path, false) == count_lines(path, false));
+    REQUIRE(count_lines_async(path, true) == count_lines(path, true));
+    std::filesystem::remove(path);
+  }
+}
+
+TEST_CASE("read_text_file_by_blocks validates UTF-8 and normalizes line endings", "[read_file_by_blocks][files]")
+{
+  // Valid: 2-, 3- and 4-byte sequences; invalid: lone continuation, overlong, surrogate, bad lead, truncated
+  std::string body = "caf\xC3\xA9\r\n\xE2\x82\xAC 10\r\nlone\rcr\n\xF0\x9F\x98\x80\r\n";
+  std::string content = "\xEF\xBB\xBF" + body + "x\x80y\r\n\xC0\xAF\r\n\xED\xA0\x80\r\n\xFF\r\n\xE2\x82";
+  for (int i = 0; i < 50; i++) {
+    content += "plain ascii line that is long enough for the SIMD path " + std::to_string(i) + "\r\n";
+  }
+  content += "end\r";
+  const std::string path = write_temp_file("cpp_utils_text_blocks_test.csv", content);
+
+  std::string expected = content.substr(3);
+  for (size_t pos; (pos = expected.find("\r\n")) != std::string::npos;) {
+    expected.erase(pos, 1);
+  }
+  const size_t base = 3 + body.size();
+
+  for (size_t block_size : {size_t(1), size_t(2), size_t(3), size_t(5), size_t(64), size_t(1) << 20}) {
+    BlockReaderOptions options;
+    options.block_size = block_size;
+    std::string text;
+    TextReport report = read_text_file_by_blocks(path, [&](const char *data, size_t size, uint64_t) { text.append(data, size); }, options);
+    REQUIRE(text == expected);
+    REQUIRE(report.had_bom);
+    REQUIRE(report.nb_crlf == 3 + 4 + 50);
+    // \xC0 is an invalid lead, then \xAF a lone continuation; after the
+    // surrogate lead \xED, \xA0 and \x80 are lone continuations
+    REQUIRE(report.invalid_offsets == std::vector<uint64_t>{base + 1, base + 5, base + 6, base + 9, base + 10, base + 11, base + 14, base + 17});
+    REQUIRE(report.nb_invalid == 8);
+  }
+  std::filesystem::remove(path);
+
+  // Files shorter than a BOM, or only a BOM
+  for (const std::string &short_content : {std::string("\xEF\xBB"), std::string("\xEF\xBB\xBF"), std::string("a\r")}) {
+    const std::string short_path = write_temp_file("cpp_utils_text_blocks_short.csv", short_content);
+    BlockReaderOptions options;
+    options.block_size = 1;
+    std::string text;
+    TextReport report = read_text_file_by_blocks(short_path, [&](const char *data, size_t size, uint64_t) { text.append(data, size); }, options);
+    REQUIRE(report.had_bom == (short_content.size() == 3));
+    REQUIRE(text == (report.had_bom ? std::string() : short_content));
+    std::filesystem::remove(short_path);
+  }
+}
+
+// end
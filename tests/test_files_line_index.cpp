@@ -0,0 +1,150 @@
+#include "files.hpp"
+#include "files_line_index.hpp"
+#include <catch_amalgamated.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string write_temp_file(const std::string &name, const std::string &content)
+{
+  std::string path = (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out << content;
+  return path;
+}
+
+// Reference: offsets and contents of all physical lines
+void split_lines(const std::string &content, std::vector<uint64_t> &offsets, std::vector<std::string> &lines)
+{
+  size_t start = 0;
+  while (start < content.size()) {
+    size_t newline = content.find('\n', start);
+    size_t end = (newline == std::string::npos) ? content.size() : newline;
+    offsets.push_back(start);
+    lines.push_back(content.substr(start, end - start));
+    start = end + 1;
+  }
+}
+
+} // namespace
+
+TEST_CASE("build_line_index records every Kth line offset", "[line_index][files]")
+{
+  std::string content = "Gmt time;Open\n";
+  for (int i = 0; i < 1000; i++) {
+    content += "01.02.2013 00:00:00.000;" + std::to_string(i) + "\n";
+    if (i % 17 == 0) {
+      content += "\n";
+    }
+  }
+  content += "last line without newline";
+  const std::string path = write_temp_file("cpp_utils_line_index.csv", content);
+  std::filesystem::remove(path + ".lidx");
+
+  std::vector<uint64_t> offsets;
+  std::vector<std::string> lines;
+  split_lines(content, offsets, lines);
+
+  for (uint64_t stride : {1, 3, 64, 5000}) {
+    LineIndex index = build_line_index(path, stride);
+
+    REQUIRE(index.nb_lines == lines.size());
+    REQUIRE(index.nb_non_empty_lines == count_lines(path, false));
+    REQUIRE(index.offsets.size() == (lines.size() + stride - 1) / stride);
+
+    for (uint64_t line = 0; line < lines.size(); line += 7) {
+      REQUIRE(line_offset(index, path, line) == offsets[line]);
+    }
+
+    std::vector<std::string> expected(lines.begin() + 100, lines.begin() + 110);
+    REQUIRE(read_lines(index, path, 100, 110) == expected);
+    REQUIRE(read_lines(index, path, lines.size() - 1, lines.size() + 10) == std::vector<std::string>{"last line without newline"});
+    REQUIRE(read_lines(index, path, 10, 10).empty());
+    REQUIRE_THROWS_AS(line_offset(index, path, lines.size()), std::out_of_range);
+  }
+
+  SECTION("Sidecar file round trip")
+  {
+    LineIndex index = build_line_index(path, 10);
+    save_line_index(index, path + ".lidx");
+
+    LineIndex loaded;
+    REQUIRE(load_line_index(path + ".lidx", loaded));
+    REQUIRE(loaded.offsets == index.offsets);
+    REQUIRE(loaded.nb_lines == index.nb_lines);
+    REQUIRE(loaded.nb_non_empty_lines == index.nb_non_empty_lines);
+    REQUIRE(loaded.file_size == index.file_size);
+    REQUIRE(loaded.file_mtime == index.file_mtime);
+    REQUIRE(loaded.stride == 10);
+    REQUIRE(is_line_index_fresh(loaded, path));
+  }
+
+  SECTION("Index is invalidated when the file changes")
+  {
+    LineIndex index = get_line_index(path, 10);
+    REQUIRE(std::filesystem::exists(path + ".lidx"));
+    REQUIRE(is_line_index_fresh(index, path));
+
+    write_temp_file("cpp_utils_line_index.csv", "a\nb\n");
+    REQUIRE_FALSE(is_line_index_fresh(index, path));
+
+    LineIndex rebuilt = get_line_index(path, 10);
+    REQUIRE(rebuilt.nb_lines == 2);
+    REQUIRE(read_lines(rebuilt, path, 0, 2) == std::vector<std::string>{"a", "b"});
+  }
+
+  SECTION("Missing or corrupt sidecar files are rejected")
+  {
+    LineIndex loaded;
+    REQUIRE_FALSE(load_line_index(path + ".missing", loaded));
+    write_temp_file("cpp_utils_line_index.csv.bad", "CPPULIDX\x01");
+    REQUIRE_FALSE(load_line_index(path + ".bad", loaded));
+    std::filesystem::remove(path + ".bad");
+  }
+
+  SECTION("Inconsistent offsets are rejected and rebuilt")
+  {
+    const LineIndex index = build_line_index(path, 10);
+    const std::string index_path = path + ".lidx";
+    LineIndex loaded;
+
+    LineIndex truncated = index;
+    truncated.offsets.resize(truncated.offsets.size() / 2);
+    save_line_index(truncated, index_path);
+    REQUIRE_FALSE(load_line_index(index_path, loaded));
+    LineIndex rebuilt = get_line_index(path, 10);
+    REQUIRE(rebuilt.offsets == index.offsets);
+    REQUIRE(read_lines(rebuilt, path, lines.size() - 1, lines.size()) == std::vector<std::string>{"last line without newline"});
+
+    LineIndex not_increasing = index;
+    not_increasing.offsets[3] = not_increasing.offsets[2];
+    save_line_index(not_increasing, index_path);
+    REQUIRE_FALSE(load_line_index(index_path, loaded));
+
+    LineIndex beyond_end = index;
+    beyond_end.offsets.back() = beyond_end.file_size;
+    save_line_index(beyond_end, index_path);
+    REQUIRE_FALSE(load_line_index(index_path, loaded));
+  }
+
+  std::filesystem::remove(path);
+  std::filesystem::remove(path + ".lidx");
+}
+
+TEST_CASE("build_line_index handles empty files", "[line_index][files]")
+{
+  const std::string path = write_temp_file("cpp_utils_line_index_empty.csv", "");
+  LineIndex index = build_line_index(path, 4);
+  REQUIRE(index.nb_lines == 0);
+  REQUIRE(index.offsets.empty());
+  REQUIRE(read_lines(index, path, 0, 10).empty());
+  REQUIRE_THROWS_AS(build_line_index(path, 0), std::invalid_argument);
+  std::filesystem::remove(path);
+}
+
+// end
@@ -0,0 +1,91 @@
+#include "files.hpp"
+#include "files_parallel_ingest.hpp"
+#include <catch_amalgamated.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("ingest_directory hands every line exactly once", "[ingest][files]")
+{
+  namespace fs = std::filesystem;
+  const fs::path directory = fs::temp_directory_path() / "cpp_utils_ingest_test";
+  fs::remove_all(directory);
+  fs::create_directories(directory);
+
+  std::vector<std::string> contents = {
+      "",
+      "single line without newline",
+      "\n\n\n",
+      "a\nbb\n\nccc\n",
+      "header\r\nrow\r\n"};
+  std::string big;
+  for (int i = 0; i < 3000; i++) {
+    big += "01.02.2013 00:00:00.000;" + std::to_string(i) + (i % 13 == 0 ? "\n\n" : "\n");
+  }
+  contents.push_back(big);
+
+  for (size_t i = 0; i < contents.size(); i++) {
+    std::ofstream out(directory / ("file_" + std::to_string(i) + ".csv"), std::ios::binary);
+    out << contents[i];
+  }
+  std::ofstream(directory / "ignored.txt") << "not a csv\n";
+
+  for (uint64_t chunk_size : {1, 5, 64, 4096, 1 << 20}) {
+    for (int nb_threads : {1, 4}) {
+      IngestOptions options;
+      options.chunk_size = chunk_size;
+      options.nb_threads = nb_threads;
+      options.extension = ".csv";
+
+      std::mutex mutex;
+      std::map<size_t, std::map<uint64_t, std::string>> chunks; // file -> offset -> bytes
+      auto results = ingest_directory(directory.string(), [&](size_t file_index, uint64_t offset, const char *begin, const char *end) {
+        std::lock_guard<std::mutex> lock(mutex);
+        chunks[file_index][offset] = std::string(begin, end);
+      }, options);
+
+      REQUIRE(results.size() == contents.size());
+      for (size_t i = 0; i < results.size(); i++) {
+        REQUIRE(results[i].error.empty());
+        REQUIRE(results[i].filename == (directory / ("file_" + std::to_string(i) + ".csv")).string());
+        REQUIRE(results[i].bytes == contents[i].size());
+        REQUIRE(results[i].nb_lines == count_lines(results[i].filename, false));
+
+        std::string reassembled;
+        for (const auto &chunk : chunks[i]) {
+          REQUIRE(chunk.first == reassembled.size());
+          REQUIRE((chunk.second.empty() || chunk.first == 0 || contents[i][chunk.first - 1] == '\n'));
+          reassembled += chunk.second;
+        }
+        REQUIRE(reassembled == contents[i]);
+      }
+    }
+  }
+
+  SECTION("Errors are reported per file")
+  {
+    auto results = ingest_files({(directory / "file_3.csv").string(), (directory / "missing.csv").string()},
+                                [](size_t file_index, uint64_t, const char *, const char *) {
+                                  if (file_index == 0) {
+                                    throw std::runtime_error("parse error");
+                                  }
+                                });
+    REQUIRE(results[0].error == "parse error");
+    REQUIRE_FALSE(results[1].error.empty());
+  }
+
+  fs::remove_all(directory);
+}
+
+TEST_CASE("ingest_directory rejects missing directories", "[ingest][files]")
+{
+  REQUIRE_THROWS_AS(ingest_directory("/nonexistent/cpp_utils", [](size_t, uint64_t, const char *, const char *) {}),
+                    std::runtime_error);
+}
+
+// end
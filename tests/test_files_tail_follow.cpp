@@ -0,0 +1,95 @@
+#include "files_tail_follow.hpp"
+#include <catch_amalgamated.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void append(const std::string &path, const std::string &text, bool truncate = false)
+{
+  std::ofstream out(path, std::ios::binary | (truncate ? std::ios::trunc : std::ios::app));
+  out << text;
+}
+
+} // namespace
+
+TEST_CASE("TailFollower delivers only new complete lines", "[tail_follow][files]")
+{
+  const std::string path = (std::filesystem::temp_directory_path() / "cpp_utils_tail_follow_test.csv").string();
+  append(path, "header\nrow 1\nrow", true);
+
+  std::vector<std::string> lines;
+  auto collect = [&](std::string_view line) { lines.emplace_back(line); };
+
+  SECTION("From the beginning, keeping the partial trailing line")
+  {
+    TailFollower follower(path);
+    REQUIRE(follower.poll(collect) == 2);
+    REQUIRE(lines == std::vector<std::string>{"header", "row 1"});
+    REQUIRE(follower.poll(collect) == 0);
+
+    append(path, " 2\n\nrow 3\nro");
+    REQUIRE(follower.poll(collect) == 2);
+    REQUIRE(lines == std::vector<std::string>{"header", "row 1", "row 2", "row 3"});
+    REQUIRE(follower.offset() == std::filesystem::file_size(path));
+
+    append(path, "w 4\n");
+    REQUIRE(follower.poll(collect) == 1);
+    REQUIRE(lines.back() == "row 4");
+  }
+
+  SECTION("From the end, skipping existing content")
+  {
+    TailFollower follower(path, true);
+    REQUIRE(follower.poll(collect) == 0);
+
+    append(path, " 2\nrow 3\n");
+    REQUIRE(follower.poll(collect) == 1);
+    REQUIRE(lines == std::vector<std::string>{"row 3"});
+  }
+
+  SECTION("Restarts from the beginning when the file is truncated")
+  {
+    TailFollower follower(path);
+    follower.poll(collect);
+    lines.clear();
+
+    append(path, "new\n", true);
+    REQUIRE(follower.poll(collect) == 1);
+    REQUIRE(lines == std::vector<std::string>{"new"});
+  }
+
+  SECTION("wait_and_poll wakes up when the file grows")
+  {
+    TailFollower follower(path, true);
+    std::thread writer([&]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      append(path, " 2\nrow 3\n");
+    });
+    size_t n = follower.wait_and_poll(collect, std::chrono::milliseconds(5000));
+    writer.join();
+    REQUIRE(n == 1);
+    REQUIRE(lines == std::vector<std::string>{"row 3"});
+  }
+
+  SECTION("wait_and_poll returns 0 when the timeout expires")
+  {
+    TailFollower follower(path, true);
+    REQUIRE(follower.wait_and_poll(collect, std::chrono::milliseconds(10)) == 0);
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("TailFollower rejects missing files", "[tail_follow][files]")
+{
+  REQUIRE_THROWS_AS(TailFollower("/nonexistent/cpp_utils.csv"), std::runtime_error);
+}
+
+// end
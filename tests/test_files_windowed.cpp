@@ -0,0 +1,74 @@
+#include "files.hpp"
+#include "files_windowed.hpp"
+#include <algorithm>
+#include <catch_amalgamated.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+void write_file(const std::string &path, const std::string &content)
+{
+  std::ofstream out(path, std::ios::binary);
+  out << content;
+}
+
+} // namespace
+
+TEST_CASE("process_file_in_windows delivers whole lines within the budget", "[files_windowed][files]")
+{
+  const std::string path = (std::filesystem::temp_directory_path() / "cpp_utils_windowed_test.csv").string();
+
+  std::string content = "Gmt time;Close\n";
+  for (int i = 0; i < 20'000; i++) {
+    content += "01.02.2013 00:00:00.000;1," + std::to_string(i) + "\n";
+    if (i % 1000 == 0) {
+      content += "\n";
+    }
+  }
+  content += "last line without newline";
+  write_file(path, content);
+
+  WindowOptions options;
+  options.memory_budget = 16 << 10;
+
+  std::string reassembled;
+  uint64_t expected_offset = 0;
+  size_t nb_windows = process_file_in_windows(
+      path,
+      [&](const char *begin, const char *end, uint64_t offset) {
+        REQUIRE(offset == expected_offset);
+        REQUIRE(static_cast<size_t>(end - begin) <= options.memory_budget / 2);
+        REQUIRE((end == begin + (content.size() - offset) || end[-1] == '\n'));
+        reassembled.append(begin, end);
+        expected_offset += static_cast<uint64_t>(end - begin);
+      },
+      options);
+
+  REQUIRE(reassembled == content);
+  REQUIRE(nb_windows > content.size() / (options.memory_budget / 2));
+  REQUIRE(count_lines_windowed(path, true, options) == count_lines(path, true));
+  REQUIRE(count_lines_windowed(path, false) == count_lines(path, false));
+
+  SECTION("Reducer")
+  {
+    size_t nb_semicolons = reduce_file_in_windows(
+        path, size_t(0), [](size_t n, const char *begin, const char *end) { return n + static_cast<size_t>(std::count(begin, end, ';')); },
+        options);
+    REQUIRE(nb_semicolons == 20'001);
+  }
+
+  SECTION("Edge cases")
+  {
+    write_file(path, "");
+    REQUIRE(process_file_in_windows(path, [](const char *, const char *, uint64_t) {}) == 0);
+    write_file(path, std::string(options.memory_budget, 'x') + "\n");
+    REQUIRE_THROWS_AS(process_file_in_windows(path, [](const char *, const char *, uint64_t) {}, options), std::runtime_error);
+    REQUIRE_THROWS_AS(process_file_in_windows(path + ".missing", [](const char *, const char *, uint64_t) {}), std::runtime_error);
+    options.memory_budget = 100;
+    REQUIRE_THROWS_AS(process_file_in_windows(path, [](const char *, const char *, uint64_t) {}, options), std::invalid_argument);
+  }
+
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,98 @@
+#include "latency_histogram.hpp"
+#include <catch_amalgamated.hpp>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("LatencyHistogram buckets are log-linear", "[latency_histogram]")
+{
+  LatencyHistogram h(7);
+  REQUIRE(h.bucket_count() == (65 - 7) * 128);
+  // Exact up to 2^8
+  for (uint64_t v = 0; v < 256; v++) {
+    REQUIRE(h.bucket_index(v) == v);
+    REQUIRE(h.bucket_lowest_value(h.bucket_index(v)) == v);
+    REQUIRE(h.bucket_highest_value(h.bucket_index(v)) == v);
+  }
+  // Then buckets of 2, 4, ... values; every value lies in its bucket, within 1/128
+  const std::vector<uint64_t> values = {256, 257, 1000, 123'456'789, 1ULL << 40, (1ULL << 40) + 12345, UINT64_MAX};
+  for (uint64_t v : values) {
+    size_t i = h.bucket_index(v);
+    REQUIRE(i < h.bucket_count());
+    REQUIRE(h.bucket_lowest_value(i) <= v);
+    REQUIRE(h.bucket_highest_value(i) >= v);
+    REQUIRE(static_cast<double>(h.bucket_highest_value(i) - h.bucket_lowest_value(i)) <=
+            static_cast<double>(h.bucket_lowest_value(i)) / 128.0);
+  }
+  REQUIRE(h.bucket_index(UINT64_MAX) == h.bucket_count() - 1);
+  REQUIRE(h.bucket_highest_value(h.bucket_count() - 1) == UINT64_MAX);
+  // Buckets are contiguous
+  for (size_t i = 1; i < h.bucket_count(); i++) {
+    REQUIRE(h.bucket_lowest_value(i) == h.bucket_highest_value(i - 1) + 1);
+  }
+
+  REQUIRE_THROWS_AS(LatencyHistogram(0), std::invalid_argument);
+}
+
+TEST_CASE("LatencyHistogram percentiles, merge and export", "[latency_histogram]")
+{
+  LatencyHistogram empty;
+  REQUIRE(empty.count() == 0);
+  REQUIRE(empty.percentile(99.0) == 0);
+  REQUIRE(empty.min() == 0);
+
+  LatencyHistogram h;
+  for (uint64_t v = 1; v <= 10'000; v++) {
+    h.record(v);
+  }
+  REQUIRE(h.count() == 10'000);
+  REQUIRE(h.min() == 1);
+  REQUIRE(h.max() == 10'000);
+  REQUIRE_THAT(h.mean(), Catch::Matchers::WithinAbs(5000.5, 1e-9));
+  REQUIRE(h.percentile(0.0) == 1);
+  REQUIRE(h.percentile(100.0) == 10'000);
+  for (double p : {50.0, 90.0, 99.0, 99.9}) {
+    double exact = p * 100.0;
+    REQUIRE(static_cast<double>(h.percentile(p)) >= exact);
+    REQUIRE(static_cast<double>(h.percentile(p)) <= exact * (1.0 + 1.0 / 128.0));
+  }
+
+  // A tail that min/max alone would not show
+  LatencyHistogram a, b;
+  a.record(100, 9990);
+  b.record(50'000, 10);
+  a.merge(b);
+  REQUIRE(a.count() == 10'000);
+  REQUIRE(a.percentile(99.0) == 100);
+  REQUIRE(a.percentile(99.95) >= 50'000);
+  REQUIRE(a.max() == 50'000);
+  REQUIRE_THROWS_AS(a.merge(LatencyHistogram(5)), std::invalid_argument);
+
+  std::ostringstream out;
+  write_percentile_distribution(a, out, 1000.0);
+  REQUIRE(out.str().find("Percentile") != std::string::npos);
+  REQUIRE(out.str().find("0.100 0.999000000000       9990") != std::string::npos);
+  REQUIRE(out.str().find("Total count    =        10000") != std::string::npos);
+
+  a.reset();
+  REQUIRE(a.count() == 0);
+  REQUIRE(a.max() == 0);
+}
+
+TEST_CASE("LatencyScope records elapsed nanoseconds", "[latency_histogram]")
+{
+  LatencyHistogram h;
+  for (int i = 0; i < 100; i++) {
+    LatencyScope scope(h);
+  }
+  REQUIRE(h.count() == 100);
+  REQUIRE(h.max() < 1'000'000'000);
+
+  std::ostringstream out;
+  print_latency_summary("empty", h, out);
+  REQUIRE(out.str().rfind("empty: 100 values", 0) == 0);
+}
+
+// end
@@ -0,0 +1,80 @@
+#include "benchmark.hpp"
+#include "perf_counters.hpp"
+#include <catch_amalgamated.hpp>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+TEST_CASE("PerfCounts accumulate and derive IPC", "[perf_counters]")
+{
+  PerfCounts a;
+  a.available = PERF_CYCLES | PERF_INSTRUCTIONS;
+  a.cycles = 100;
+  a.instructions = 250;
+  PerfCounts b;
+  b.available = PERF_CYCLES | PERF_INSTRUCTIONS | PERF_BRANCH_MISSES;
+  b.cycles = 100;
+  b.instructions = 150;
+  b.branch_misses = 4;
+  a += b;
+  REQUIRE(a.available == (PERF_CYCLES | PERF_INSTRUCTIONS | PERF_BRANCH_MISSES));
+  REQUIRE(a.cycles == 200);
+  REQUIRE(a.branch_misses == 4);
+  REQUIRE(a.ipc() == 2.0);
+  REQUIRE(PerfCounts().ipc() == 0.0);
+
+  std::ostringstream out;
+  print_perf_counts(a, 100.0, out);
+  REQUIRE(out.str().find("2.000 cycles, 4.000 instructions,") != std::string::npos);
+  REQUIRE(out.str().find("0.040 branch misses") != std::string::npos);
+  REQUIRE(out.str().find("IPC 2.000") != std::string::npos);
+  REQUIRE(out.str().find("L1d") == std::string::npos);
+
+  std::ostringstream none;
+  print_perf_counts(PerfCounts(), 1.0, none);
+  REQUIRE(none.str().find("unavailable") != std::string::npos);
+}
+
+TEST_CASE("PerfCounterGroup degrades gracefully", "[perf_counters]")
+{
+  PerfCounterGroup group(PERF_CYCLES | PERF_INSTRUCTIONS);
+  REQUIRE((group.counters() & ~(PERF_CYCLES | PERF_INSTRUCTIONS)) == 0);
+  if (group.counters() != (PERF_CYCLES | PERF_INSTRUCTIONS)) {
+    REQUIRE(!group.unavailable_reason().empty());
+  }
+
+  PerfCounts counts;
+  uint64_t sum = 0;
+  {
+    PerfScope scope(group, counts);
+    for (uint64_t i = 0; i < 1'000'000; i++) {
+      sum += i * i;
+      do_not_optimize(sum);
+    }
+  }
+  REQUIRE(counts.available == group.counters());
+  if (counts.available & PERF_INSTRUCTIONS) {
+    REQUIRE(counts.instructions > 1'000'000);
+  } else {
+    REQUIRE(counts.instructions == 0);
+  }
+
+  BenchmarkOptions options;
+  options.min_runs = 3;
+  options.max_runs = 3;
+  options.perf_counters = PERF_ALL;
+  options.items_per_run = 1000;
+  BenchmarkResult result = benchmark(
+      [] {
+        uint64_t s = 0;
+        for (uint64_t i = 0; i < 1000; i++) {
+          s += i;
+          do_not_optimize(s);
+        }
+      },
+      options);
+  REQUIRE(result.items_per_run == 1000);
+  REQUIRE(result.counters.available == PerfCounterGroup(PERF_ALL).counters());
+}
+
+// end
@@ -0,0 +1,52 @@
+#include "segmented_column.hpp"
+#include <catch_amalgamated.hpp>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+TEST_CASE("SegmentedColumn grows without relocating", "[segmented_column]")
+{
+  SegmentedColumn<double, 1024> column;
+  REQUIRE(column.block_size == 128);
+  REQUIRE(column.empty());
+  REQUIRE(column.nb_blocks() == 0);
+  REQUIRE(column.flatten().empty());
+
+  column.push_back(0.0);
+  const double *first = &column[0];
+  for (int i = 1; i < 1'000; i++) {
+    column.push_back(i * 0.5);
+  }
+  REQUIRE(&column[0] == first); // never relocated
+  REQUIRE(column.size() == 1'000);
+  REQUIRE(column.nb_blocks() == 8);
+  REQUIRE(column.block_length(0) == 128);
+  REQUIRE(column.block_length(7) == 1'000 - 7 * 128);
+  REQUIRE(column[999] == 499.5);
+
+  for (size_t b = 0; b < column.nb_blocks(); b++) {
+    REQUIRE(reinterpret_cast<std::uintptr_t>(column.block_data(b)) % 64 == 0);
+  }
+
+  double sum = 0.0;
+  size_t n = 0;
+  column.for_each_block([&](const double *data, size_t length) {
+    sum += std::accumulate(data, data + length, 0.0);
+    n += length;
+  });
+  REQUIRE(n == 1'000);
+  REQUIRE(sum == 0.5 * 999 * 1'000 / 2);
+
+  std::vector<double> flat = column.flatten();
+  REQUIRE(flat.size() == 1'000);
+  for (size_t i = 0; i < flat.size(); i++) {
+    REQUIRE(flat[i] == column[i]);
+  }
+
+  column[3] = -1.0;
+  REQUIRE(column.flatten()[3] == -1.0);
+
+  column.clear();
+  REQUIRE(column.empty());
+  REQUIRE(column.nb_blocks() == 0);
+}
@@ -0,0 +1,37 @@
+#include "stopwatch.hpp"
+#include <catch_amalgamated.hpp>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("Stopwatch is calibrated and agrees with steady_clock", "[stopwatch]")
+{
+  const StopwatchCalibration &calibration = stopwatch_calibration();
+  REQUIRE(calibration.ticks_per_second > 1e8);
+  REQUIRE(calibration.ticks_per_second < 1e11);
+  REQUIRE(ticks_to_seconds(calibration.overhead_ticks) < 1e-5);
+  if (!calibration.uses_tsc) {
+    REQUIRE(calibration.ticks_per_second == 1e9);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  Stopwatch sw;
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  double seconds = sw.elapsed_seconds();
+  double reference = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  REQUIRE(seconds >= 0.049);
+  REQUIRE(seconds <= reference * 1.02 + 1e-4);
+  REQUIRE(sw.elapsed().count() >= seconds);
+  REQUIRE(sw.elapsed_nanoseconds() >= 1e9 * seconds);
+
+  uint64_t previous = stopwatch_ticks_begin();
+  for (int i = 0; i < 1000; i++) {
+    uint64_t now = stopwatch_ticks_end();
+    REQUIRE(now >= previous);
+    previous = now;
+  }
+
+  sw.restart();
+  REQUIRE(sw.elapsed_seconds() < seconds);
+}
+
+// end
@@ -0,0 +1,90 @@
+#include "trace.hpp"
+#include <catch_amalgamated.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if !defined(CPP_UTILS_NO_TRACE)
+
+namespace {
+
+size_t count_occurrences(const std::string &text, const std::string &pattern)
+{
+  size_t count = 0;
+  for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+    count++;
+  }
+  return count;
+}
+
+std::string read_file(const std::string &filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  return buffer.str();
+}
+
+} // namespace
+
+#endif
+
+TEST_CASE("TRACE_SCOPE events are exported as a Chrome trace", "[trace]")
+{
+  const std::string path = (std::filesystem::temp_directory_path() / "cpp_utils_trace_test.json").string();
+  clear_trace();
+  {
+    TRACE_SCOPE("outer");
+    for (int i = 0; i < 3; i++) {
+      TRACE_SCOPE("inner \"quoted\"");
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+  std::thread worker([] {
+    set_trace_thread_name("worker");
+    for (size_t i = 0; i < TraceBuffer::capacity + 10; i++) {
+      TRACE_SCOPE("tiny");
+    }
+  });
+  worker.join();
+
+#if !defined(CPP_UTILS_NO_TRACE)
+  REQUIRE(write_trace(path) == 4 + TraceBuffer::capacity);
+  std::string json = read_file(path);
+  REQUIRE(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0) == 0);
+  REQUIRE(json.find("\n]}\n") == json.size() - 4);
+  REQUIRE(count_occurrences(json, "\"name\":\"outer\"") == 1);
+  REQUIRE(count_occurrences(json, "\"name\":\"inner \\\"quoted\\\"\"") == 3);
+  REQUIRE(count_occurrences(json, "\"name\":\"tiny\"") == TraceBuffer::capacity);
+  REQUIRE(count_occurrences(json, "\"args\":{\"name\":\"worker\"}") == 1);
+
+  // The outer scope lasts at least the 3 ms of the inner ones
+  size_t outer = json.find("\"name\":\"outer\"");
+  size_t dur = json.find("\"dur\":", outer);
+  REQUIRE(std::stod(json.substr(dur + 6)) >= 3000.0);
+
+  // A thread started after another exited reuses its buffer (same tid)
+  clear_trace();
+  std::thread([] { TRACE_SCOPE("first"); }).join();
+  std::thread([] { TRACE_SCOPE("second"); }).join();
+  REQUIRE(write_trace(path) == 2);
+  json = read_file(path);
+  auto tid_of = [&](const std::string &name) {
+    size_t tid = json.find("\"tid\":", json.find("\"name\":\"" + name + "\""));
+    return json.substr(tid, json.find(',', tid) - tid);
+  };
+  REQUIRE(tid_of("first") == tid_of("second"));
+#else
+  REQUIRE(write_trace(path) == 0);
+#endif
+
+  clear_trace();
+  REQUIRE(write_trace(path) == 0);
+  std::filesystem::remove(path);
+  REQUIRE_THROWS_AS(write_trace("/nonexistent/dir/trace.json"), std::runtime_error);
+}
+
+// end
@@ -0,0 +1,48 @@
+// Compares two benchmark result files (written by write_benchmark_json)
+// and exits with status 1 if a benchmark regressed significantly.
+//
+//   build/compare_benchmarks baseline.json candidate.json [min_change] [alpha]
+//
+// min_change: relative slowdown of the median to report (default 0.05)
+// alpha: significance level of the Mann-Whitney U test (default 0.01)
+// Exit status: 0 no regression, 1 regression, 2 usage or file error.
+
+#include "benchmark_report.hpp"
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+
+int main(int argc, char **argv)
+{
+  if (argc < 3 || argc > 5) {
+    std::cerr << "Usage: " << argv[0] << " baseline.json candidate.json [min_change] [alpha]" << std::endl;
+    return 2;
+  }
+  try {
+    double min_change = (argc > 3) ? std::stod(argv[3]) : 0.05;
+    double alpha = (argc > 4) ? std::stod(argv[4]) : 0.01;
+    BenchmarkReport baseline = read_benchmark_json(argv[1]);
+    BenchmarkReport candidate = read_benchmark_json(argv[2]);
+
+    std::cout << "Baseline:  revision " << baseline.environment.git_revision << ", " << baseline.environment.date
+              << ", " << baseline.environment.cpu << std::endl;
+    std::cout << "Candidate: revision " << candidate.environment.git_revision << ", " << candidate.environment.date
+              << ", " << candidate.environment.cpu << std::endl;
+    if (baseline.environment.cpu != candidate.environment.cpu ||
+        baseline.environment.compiler_flags != candidate.environment.compiler_flags) {
+      std::cout << "Warning: different CPU or compiler flags" << std::endl;
+    }
+
+    auto comparisons = compare_benchmarks(baseline, candidate, min_change, alpha);
+    if (comparisons.empty()) {
+      std::cout << "No benchmark in common" << std::endl;
+    }
+    return print_benchmark_comparison(comparisons, std::cout) ? 1 : 0;
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return 2;
+  }
+}
+
+// end